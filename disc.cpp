@@ -11,6 +11,7 @@
 #include "mednafen/ss/ss.h"
 #include "mednafen/ss/cdb.h"
 #include "mednafen/ss/smpc.h"
+#include "libretro_settings.h"
 
 //------------------------------------------------------------------------------
 // Locals
@@ -23,7 +24,9 @@ static int g_current_disc;
 static unsigned g_initial_disc;
 static std::string g_initial_disc_path;
 
+// Entries for discs of an M3U set that haven't been selected yet are NULL; see disc_get().
 static std::vector<CDIF *> CDInterfaces;
+static bool g_image_memcache;
 
 static std::vector<std::string> disk_image_paths;
 static std::vector<std::string> disk_image_labels;
@@ -122,6 +125,34 @@ static bool IsSaturnDisc( const uint8* sa32k )
 	return true;
 }
 
+// Opens a disc, or throws.
+static void disc_open( unsigned index )
+{
+	log_cb(RETRO_LOG_INFO, "Opening CD: \"%s\".\n", disk_image_paths[index].c_str());
+	CDInterfaces[index] = CDIF_Open(disk_image_paths[index].c_str(), g_image_memcache, setting_lean_memory);
+}
+
+// Returns the disc's interface, opening it first if necessary; NULL if there's no image or it can't be opened.
+static CDIF* disc_get( unsigned index )
+{
+	if ( index >= CDInterfaces.size() )
+		return NULL;
+
+	if ( !CDInterfaces[index] && index < disk_image_paths.size() && !disk_image_paths[index].empty() )
+	{
+		try
+		{
+			disc_open(index);
+		}
+		catch( std::exception &e )
+		{
+			log_cb(RETRO_LOG_ERROR, "Opening \"%s\" failed: %s\n", disk_image_paths[index].c_str(), e.what());
+		}
+	}
+
+	return CDInterfaces[index];
+}
+
 static bool disk_set_eject_state( bool ejected )
 {
 	if ( ejected == g_eject_state )
@@ -165,6 +196,8 @@ static bool disk_set_image_index(unsigned index)
 	{
 		if ( index < CDInterfaces.size() ) {
 			// log_cb(RETRO_LOG_INFO, "Selected disc %d of %d.\n", index+1, CDInterfaces.size() );
+			if ( !disc_get(index) && !disk_image_paths[index].empty() )
+				return false;
 			g_current_disc = index;
 			return true;
 		}
@@ -475,11 +508,12 @@ static void CalcGameID( uint8* id_out16, uint8* fd_id_out16, char* sgid, char* s
 	md5_context mctx;
 	uint8_t buf[2048];
 
-	log_cb(RETRO_LOG_INFO, "Calculating game ID (%d discs)\n", CDInterfaces.size() );
+	log_cb(RETRO_LOG_INFO, "Calculating game ID\n" );
 
 	mctx.starts();
 
-	for(size_t x = 0; x < CDInterfaces.size(); x++)
+	// Only the first disc; the others of a set may not be opened yet, and share its product ID anyway.
+	for(size_t x = 0; x < std::min<size_t>(1, CDInterfaces.size()); x++)
 	{
 		CDIF *c = CDInterfaces[x];
 		TOC toc;
@@ -561,7 +595,7 @@ bool DetectRegion( unsigned* region )
 
 	for(auto& c : CDInterfaces)
 	{
-		if(c->ReadSector(&buf[0], 0, 16) != 0x1)
+		if(!c || c->ReadSector(&buf[0], 0, 16) != 0x1)
 			continue;
 
 		if(!IsSaturnDisc(&buf[0]))
@@ -606,6 +640,9 @@ bool DiscSanityChecks(void)
 	{
 		TOC toc;
 
+		if ( !disc_get(i) )
+			continue;
+
 		CDInterfaces[i]->ReadTOC(&toc);
 
 		// For each track
@@ -688,6 +725,7 @@ bool DiscSanityChecks(void)
 void disc_select( unsigned disc_num )
 {
 	if ( disc_num < CDInterfaces.size() ) {
+		disc_get(disc_num);
 		g_current_disc = disc_num;
 		CDB_SetDisc( false, CDInterfaces[ g_current_disc ] );
 	}
@@ -700,6 +738,8 @@ bool disc_load_content( MDFNGI* game_interface, const char* content_name, uint8*
 	if ( !content_name )
 		return false;
 
+	g_image_memcache = image_memcache;
+
 	uint8 LayoutMD5[ 16 ];
 
 	log_cb( RETRO_LOG_INFO, "Loading \"%s\"\n", content_name );
@@ -720,8 +760,7 @@ bool disc_load_content( MDFNGI* game_interface, const char* content_name, uint8*
 					bool success = true;
 					image_label[0] = '\0';
 					log_cb(RETRO_LOG_INFO, "Adding CD: \"%s\".\n", disk_image_paths[i].c_str());
-					CDIF *image = CDIF_Open(disk_image_paths[i].c_str(), image_memcache);
-					CDInterfaces.push_back(image);
+					CDInterfaces.push_back(NULL);
 					extract_basename(
 					image_label,
 					disk_image_paths[i].c_str(),
@@ -738,7 +777,7 @@ bool disc_load_content( MDFNGI* game_interface, const char* content_name, uint8*
 				image_label[0] = '\0';
 
 				disk_image_paths.push_back(content_name);
-				CDIF *image  = CDIF_Open(content_name, image_memcache);
+				CDIF *image  = CDIF_Open(content_name, image_memcache, setting_lean_memory);
 				CDInterfaces.push_back(image);
 
 				extract_basename(
@@ -760,6 +799,13 @@ bool disc_load_content( MDFNGI* game_interface, const char* content_name, uint8*
 					g_initial_disc_path.c_str()))
 						g_current_disc = (int)
 							g_initial_disc;
+
+			// Open the first disc(for the game ID) and the initial disc now, the rest when first selected.
+			if ( !CDInterfaces.empty() && !CDInterfaces[0] )
+				disc_open(0);
+
+			if ( (size_t)g_current_disc < CDInterfaces.size() && !CDInterfaces[g_current_disc] )
+				disc_open(g_current_disc);
 		}
 	}
 	catch( std::exception &e )
@@ -772,6 +818,8 @@ bool disc_load_content( MDFNGI* game_interface, const char* content_name, uint8*
 	for(unsigned i = 0; i < CDInterfaces.size(); i++)
 	{
 		TOC toc;
+		if ( !CDInterfaces[i] )
+			continue;
 		CDInterfaces[i]->ReadTOC(&toc);
 		log_cb(RETRO_LOG_DEBUG, "Disc %d\n", i + 1);
 		for(int32 track = toc.first_track; track <= toc.last_track; track++) {
@@ -791,6 +839,9 @@ bool disc_load_content( MDFNGI* game_interface, const char* content_name, uint8*
 		{
 			TOC toc;
 
+			if ( !CDInterfaces[i] )
+				continue;
+
 			CDInterfaces[i]->ReadTOC(&toc);
 
 			layout_md5.update_u32_as_lsb(toc.first_track);
@@ -8,6 +8,8 @@
 #include <ctype.h>
 #include <time.h>
 
+#include <thread>
+
 #include "mednafen/mednafen-types.h"
 #include "mednafen/git.h"
 #include "mednafen/general.h"
@@ -41,6 +43,7 @@
 #define MEDNAFEN_CORE_GEOMETRY_MAX_H         576
 #define MEDNAFEN_CORE_GEOMETRY_ASPECT_RATIO  (4.0 / 3.0)
 #define FB_WIDTH                             MEDNAFEN_CORE_GEOMETRY_MAX_W
+#define FB_SURFACE_COUNT                     2
 
 struct retro_perf_callback perf_cb;
 retro_get_cpu_features_t perf_get_cpu_features_cb = NULL;
@@ -106,18 +109,189 @@ static bool PrevInterlaced;
 static Deinterlacer deint;
 #endif
 
-static MDFN_Surface *surf = NULL;
+// Output surfaces are cycled so that the frame handed to video_cb() stays intact
+// while the next one is being rendered.
+static MDFN_Surface *surfs[FB_SURFACE_COUNT] = { NULL };
+static unsigned surf_index = 0;
+
+// Wraps the frontend's framebuffer(RETRO_ENVIRONMENT_GET_CURRENT_SOFTWARE_FRAMEBUFFER)
+// when the frame is rendered straight into it; re-pointed every frame.
+static MDFN_Surface *fe_surf = NULL;
+static struct retro_framebuffer fe_fb;
+static bool libretro_supports_frame_dupe = false;
+
+static const MDFN_PixelFormat surf_pix_fmt(MDFN_COLORSPACE_RGB, 16, 8, 0, 24);
+
+// Frameskip; skipped frames are still emulated in full, only VDP2 composition and
+// output are dropped, and a dupe is presented in their place.
+enum
+{
+   FRAMESKIP_DISABLED = 0,
+   FRAMESKIP_FASTFORWARD,
+   FRAMESKIP_AUTO,
+   FRAMESKIP_AUTO_THRESHOLD,
+   FRAMESKIP_FIXED_INTERVAL
+};
+
+static unsigned frameskip_type             = FRAMESKIP_DISABLED;
+static unsigned frameskip_threshold        = 0;
+static unsigned frameskip_interval         = 0;
+static unsigned frameskip_counter          = 0;
+
+static bool retro_audio_buff_active        = false;
+static unsigned retro_audio_buff_occupancy = 0;
+static bool retro_audio_buff_underrun      = false;
+static unsigned audio_latency              = 0;
+static bool update_audio_latency           = false;
+
+static void free_surfaces(void)
+{
+  for (unsigned i = 0; i < FB_SURFACE_COUNT; i++)
+  {
+    delete surfs[i];
+    surfs[i] = NULL;
+  }
+
+  delete fe_surf;
+  fe_surf = NULL;
+}
 
 static void alloc_surface(void)
 {
-  MDFN_PixelFormat pix_fmt(MDFN_COLORSPACE_RGB, 16, 8, 0, 24);
   uint32_t width  = MEDNAFEN_CORE_GEOMETRY_MAX_W;
   uint32_t height = MEDNAFEN_CORE_GEOMETRY_MAX_H;
 
-  if (surf != NULL)
-    delete surf;
+  free_surfaces();
+
+  for (unsigned i = 0; i < FB_SURFACE_COUNT; i++)
+    surfs[i] = new MDFN_Surface(NULL, width, height, width, surf_pix_fmt);
+
+  fe_surf = new MDFN_Surface();
+  fe_surf->SetFormat(surf_pix_fmt, false);
+
+  surf_index = 0;
+}
+
+static MDFN_Surface *next_internal_surface(void)
+{
+  surf_index = (surf_index + 1) % FB_SURFACE_COUNT;
+
+  return surfs[surf_index];
+}
+
+// Picks the surface to render the next frame into; width and height are the
+// output dimensions of the previous frame.
+static MDFN_Surface *acquire_surface(unsigned width, unsigned height, bool crop_origin, MDFN_Surface **fallback)
+{
+  *fallback = NULL;
+
+  // The pointer passed to video_cb() must be exactly the one the frontend gave us, so
+  // only try when the output isn't cropped at the top or left.  A frame whose size
+  // turns out different(mode change) falls back to an internal surface.
+  if (libretro_supports_frame_dupe && width && height && !crop_origin)
+  {
+    memset(&fe_fb, 0, sizeof(fe_fb));
+    fe_fb.width        = width;
+    fe_fb.height       = height;
+    fe_fb.access_flags = RETRO_MEMORY_ACCESS_WRITE;
+
+    if (environ_cb(RETRO_ENVIRONMENT_GET_CURRENT_SOFTWARE_FRAMEBUFFER, &fe_fb) && fe_fb.data &&
+        fe_fb.format == RETRO_PIXEL_FORMAT_XRGB8888 && !(fe_fb.pitch & 3) &&
+        fe_fb.width == width && fe_fb.height == height && fe_fb.pitch >= width * sizeof(uint32_t))
+    {
+      fe_surf->SetExternalPixels(fe_fb.data, fe_fb.pitch / sizeof(uint32_t), height, fe_fb.pitch / sizeof(uint32_t));
+      *fallback = next_internal_surface();
+
+      return fe_surf;
+    }
+  }
+
+  fe_fb.data = NULL;
+
+  return next_internal_surface();
+}
 
-  surf = new MDFN_Surface(NULL, width, height, width, pix_fmt);
+static void retro_audio_buff_status_cb(bool active, unsigned occupancy, bool underrun_likely)
+{
+   retro_audio_buff_active    = active;
+   retro_audio_buff_occupancy = occupancy;
+   retro_audio_buff_underrun  = underrun_likely;
+}
+
+static void init_frameskip(void)
+{
+   if (frameskip_type == FRAMESKIP_AUTO || frameskip_type == FRAMESKIP_AUTO_THRESHOLD)
+   {
+      struct retro_audio_buffer_status_callback buf_status_cb;
+
+      buf_status_cb.callback = retro_audio_buff_status_cb;
+      if (!environ_cb(RETRO_ENVIRONMENT_SET_AUDIO_BUFFER_STATUS_CALLBACK, &buf_status_cb))
+      {
+         log_cb(RETRO_LOG_WARN, "Frameskip disabled - frontend does not support audio buffer status monitoring.\n");
+
+         retro_audio_buff_active    = false;
+         retro_audio_buff_occupancy = 0;
+         retro_audio_buff_underrun  = false;
+         audio_latency              = 0;
+      }
+      else
+      {
+         // Frameskip is only effective with a reasonably large audio buffer; ask for
+         // 6 frames' worth, rounded up to a multiple of 32ms.
+         float frame_time_msec = 1000.0f / (is_pal ? 49.96f : 59.88f);
+
+         audio_latency = (unsigned)((6.0f * frame_time_msec) + 0.5f);
+         audio_latency = (audio_latency + 0x1F) & ~0x1F;
+      }
+   }
+   else
+   {
+      environ_cb(RETRO_ENVIRONMENT_SET_AUDIO_BUFFER_STATUS_CALLBACK, NULL);
+      audio_latency = 0;
+   }
+
+   update_audio_latency = true;
+   frameskip_counter    = 0;
+}
+
+// Decides whether the upcoming frame is skipped. Skipping needs the frontend
+// to accept dupes, since nothing gets rendered for the frame.
+static bool check_frameskip(void)
+{
+   bool skip        = false;
+   bool fastforward = false;
+
+   if (frameskip_type == FRAMESKIP_DISABLED || !libretro_supports_frame_dupe)
+      return false;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_FASTFORWARDING, &fastforward) && fastforward)
+      skip = true;
+   else
+   {
+      switch (frameskip_type)
+      {
+         case FRAMESKIP_AUTO:
+            skip = retro_audio_buff_active && retro_audio_buff_underrun;
+            break;
+         case FRAMESKIP_AUTO_THRESHOLD:
+            skip = retro_audio_buff_active && (retro_audio_buff_occupancy < frameskip_threshold);
+            break;
+         case FRAMESKIP_FIXED_INTERVAL:
+            skip = true;
+            break;
+         default:
+            break;
+      }
+   }
+
+   if (skip && frameskip_counter < frameskip_interval)
+   {
+      frameskip_counter++;
+      return true;
+   }
+
+   frameskip_counter = 0;
+   return false;
 }
 
 static void check_system_specs(void)
@@ -280,6 +454,16 @@ static void check_variables(bool startup)
 			   shared_backup_toggle = false;
 
 	   }
+
+	   var.key = "beetle_saturn_lean_memory";
+
+	   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+	   {
+		   if (!strcmp(var.value, "enabled"))
+			   setting_lean_memory = true;
+		   else if (!strcmp(var.value, "disabled"))
+			   setting_lean_memory = false;
+	   }
    }
 
    var.key = "beetle_saturn_region";
@@ -374,6 +558,50 @@ static void check_variables(bool startup)
          setting_midsync = false;
    }
 
+   var.key = "beetle_saturn_idle_skip";
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "enabled"))
+         setting_idle_skip = true;
+      else if (!strcmp(var.value, "disabled"))
+         setting_idle_skip = false;
+   }
+
+   var.key = "beetle_saturn_sh2_quantum";
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "lockstep"))
+         setting_sh2_quantum = 0;
+      else
+         setting_sh2_quantum = atoi(var.value);
+   }
+
+   var.key = "beetle_saturn_sound_thread";
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "enabled"))
+         setting_sound_thread = true;
+      else if (!strcmp(var.value, "disabled"))
+         setting_sound_thread = false;
+   }
+
+   var.key = "beetle_saturn_cd_speed";
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "2x"))
+         setting_cd_speed_shift = 1;
+      else if (!strcmp(var.value, "4x"))
+         setting_cd_speed_shift = 2;
+      else if (!strcmp(var.value, "8x"))
+         setting_cd_speed_shift = 3;
+      else
+         setting_cd_speed_shift = 0;
+   }
+
    var.key = "beetle_saturn_autortc";
 
    if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
@@ -445,6 +673,55 @@ static void check_variables(bool startup)
       DoHBlend = newval;
    }
 
+   var.key = "beetle_saturn_frameskip";
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      unsigned old_frameskip_type = frameskip_type;
+
+      if (!strcmp(var.value, "fastforward"))
+         frameskip_type = FRAMESKIP_FASTFORWARD;
+      else if (!strcmp(var.value, "auto"))
+         frameskip_type = FRAMESKIP_AUTO;
+      else if (!strcmp(var.value, "auto_threshold"))
+         frameskip_type = FRAMESKIP_AUTO_THRESHOLD;
+      else if (!strcmp(var.value, "fixed_interval"))
+         frameskip_type = FRAMESKIP_FIXED_INTERVAL;
+      else
+         frameskip_type = FRAMESKIP_DISABLED;
+
+      if (!startup && frameskip_type != old_frameskip_type)
+         init_frameskip();
+   }
+
+   var.key = "beetle_saturn_frameskip_threshold";
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      frameskip_threshold = strtol(var.value, NULL, 10);
+
+   var.key = "beetle_saturn_frameskip_interval";
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      frameskip_interval = strtol(var.value, NULL, 10);
+
+#ifdef NEED_DEINTERLACER
+   var.key = "beetle_saturn_deinterlacer";
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "weave"))
+         deint.SetType(Deinterlacer::DEINT_WEAVE);
+      else if (!strcmp(var.value, "bob"))
+         deint.SetType(Deinterlacer::DEINT_BOB);
+      else if (!strcmp(var.value, "bob_offset"))
+         deint.SetType(Deinterlacer::DEINT_BOB_OFFSET);
+      else if (!strcmp(var.value, "blend"))
+         deint.SetType(Deinterlacer::DEINT_BLEND);
+      else if (!strcmp(var.value, "adaptive"))
+         deint.SetType(Deinterlacer::DEINT_ADAPTIVE);
+   }
+#endif
+
    var.key = "beetle_saturn_analog_stick_deadzone";
    var.value = NULL;
 
@@ -603,6 +880,10 @@ bool retro_load_game(const struct retro_game_info *info)
 
    input_init_env( environ_cb );
 
+   libretro_supports_frame_dupe = false;
+   if (!environ_cb(RETRO_ENVIRONMENT_GET_CAN_DUPE, &libretro_supports_frame_dupe))
+      libretro_supports_frame_dupe = false;
+
    enum retro_pixel_format fmt = RETRO_PIXEL_FORMAT_XRGB8888;
    if (!environ_cb(RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &fmt))
       return false;
@@ -630,10 +911,17 @@ bool retro_load_game(const struct retro_game_info *info)
    MDFNMP_InstallReadPatches();
 
    alloc_surface();
+   init_frameskip();
 
 #ifdef NEED_DEINTERLACER
    PrevInterlaced = false;
    deint.ClearState();
+   {
+      // The emulation and VDP2 render threads already keep two cores busy.
+      const unsigned cores = std::thread::hardware_concurrency();
+
+      deint.SetThreadCount((cores > 2) ? std::min<unsigned>(cores - 2, 4) : 1);
+   }
 #endif
 
    input_init();
@@ -674,6 +962,10 @@ void retro_unload_game(void)
 
    CloseGame();
 
+#ifdef NEED_DEINTERLACER
+   deint.SetThreadCount(1);
+#endif
+
    if (MDFNGameInfo->RMD)
    {
       delete MDFNGameInfo->RMD;
@@ -702,6 +994,7 @@ void retro_run(void)
    unsigned linevisfirst, linevislast;
    static unsigned width, height;
    static unsigned game_width, game_height;
+   MDFN_Surface *surf;
 
    if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE_UPDATE, &updated) && updated)
       check_variables(false);
@@ -724,7 +1017,21 @@ void retro_run(void)
    static int32 rects[MEDNAFEN_CORE_GEOMETRY_MAX_H];
    rects[0] = ~0;
 
+   if (update_audio_latency)
+   {
+      environ_cb(RETRO_ENVIRONMENT_SET_MINIMUM_AUDIO_LATENCY, &audio_latency);
+      update_audio_latency = false;
+   }
+
    EmulateSpecStruct spec;
+   spec.skip = check_frameskip();
+
+   // Nothing is drawn into a skipped frame's surface, so don't ask the frontend for one.
+   if (spec.skip)
+      surf = surfs[surf_index];
+   else
+      surf = acquire_surface(game_width, game_height, linevisfirst || h_mask, &spec.fallback_surface);
+
    spec.surface = surf;
    spec.LineWidths = rects;
    spec.SoundBufSize = 0;
@@ -733,6 +1040,30 @@ void retro_run(void)
 
    Emulate(espec);
 
+   // The emulation code switches to the fallback surface when the frame doesn't fit the frontend's buffer.
+   surf = spec.surface;
+   if (surf != fe_surf)
+      fe_fb.data = NULL;
+
+   if (spec.skip)
+   {
+#ifdef NEED_DEINTERLACER
+      // The deinterlacer's field history is now out of step.
+      if (spec.InterlaceOn)
+         deint.ClearState();
+#endif
+      if (led_state_cb)
+         retro_led_interface();
+
+      video_cb(NULL, game_width, game_height, 0);
+
+      video_frames++;
+      audio_frames += spec.SoundBufSize;
+
+      audio_batch_cb((int16_t*)&IBuffer, spec.SoundBufSize);
+      return;
+   }
+
 #ifdef NEED_DEINTERLACER
    if (spec.InterlaceOn)
    {
@@ -751,8 +1082,8 @@ void retro_run(void)
 
 #endif
    const void *fb      = NULL;
-   const uint32_t *pix = surf->pixels;
-   size_t pitch        = FB_WIDTH * sizeof(uint32_t);
+   const uint32_t *pix;
+   size_t pitch;
 
    hires_h_mode   =  (rects[0] == 704) ? true : false;
    overscan_mask  =  (h_mask >> 1) << hires_h_mode;
@@ -784,7 +1115,21 @@ void retro_run(void)
    if (led_state_cb)
       retro_led_interface();
 
-   pix += surf->pitchinpix * (linevisfirst << PrevInterlaced) + overscan_mask;
+   // Rendered into the frontend's buffer, but the frame came out a different size
+   // than was asked for; present it from an internal surface instead.
+   if (fe_fb.data && (fe_fb.width != game_width || fe_fb.height != game_height))
+   {
+      MDFN_Surface *fallback = spec.fallback_surface;
+
+      for (int32 y = 0; y < surf->h; y++)
+         memcpy(fallback->pixels + y * fallback->pitchinpix, surf->pixels + y * surf->pitchinpix, std::min<int32>(surf->pitchinpix, fallback->pitchinpix) * sizeof(uint32_t));
+
+      surf = fallback;
+      fe_fb.data = NULL;
+   }
+
+   pix   = surf->pixels + surf->pitchinpix * (linevisfirst << PrevInterlaced) + overscan_mask;
+   pitch = surf->pitchinpix * sizeof(uint32_t);
 
    fb = pix;
 
@@ -829,8 +1174,7 @@ void retro_get_system_av_info(struct retro_system_av_info *info)
 
 void retro_deinit(void)
 {
-   delete surf;
-   surf = NULL;
+   free_surfaces();
 
    log_cb(RETRO_LOG_INFO, "[%s]: Samples / Frame: %.5f\n",
          MEDNAFEN_CORE_NAME, (double)audio_frames / video_frames);
@@ -365,6 +365,90 @@ struct retro_core_option_v2_definition option_defs_us[] = {
       },
       "disabled"
    },
+   {
+      "beetle_saturn_deinterlacer",
+      "Deinterlacing Method",
+      NULL,
+      "Choose how interlaced content(hi-res menus, FMVs) is deinterlaced. 'Weave' combines both fields for full vertical resolution, 'Bob' line-doubles each field, 'Blend' averages the two fields to reduce combing, and 'Adaptive' weaves still areas while interpolating moving ones.",
+      NULL,
+      "video",
+      {
+         { "weave",      "Weave" },
+         { "bob",        "Bob" },
+         { "bob_offset", "Bob (offset)" },
+         { "blend",      "Blend" },
+         { "adaptive",   "Adaptive" },
+         { NULL, NULL },
+      },
+      "weave"
+   },
+   {
+      "beetle_saturn_frameskip",
+      "Frameskip",
+      NULL,
+      "Skip drawing frames to reduce host GPU/CPU load; emulation itself still runs every frame. 'Fast-Forward Only' skips only while the frontend is fast-forwarding. 'Auto' also skips when the frontend reports an audio buffer underrun is likely. 'Auto (Threshold)' skips when the audio buffer occupancy drops below the 'Frameskip Threshold (%)' setting. 'Fixed Interval' always skips frames. All modes except 'Disabled' skip while fast-forwarding, and all need a frontend that supports frame duping.",
+      NULL,
+      "video",
+      {
+         { "disabled",       NULL },
+         { "fastforward",    "Fast-Forward Only" },
+         { "auto",           "Auto" },
+         { "auto_threshold", "Auto (Threshold)" },
+         { "fixed_interval", "Fixed Interval" },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+   {
+      "beetle_saturn_frameskip_threshold",
+      "Frameskip Threshold (%)",
+      NULL,
+      "When 'Frameskip' is set to 'Auto (Threshold)', specifies the audio buffer occupancy threshold (percentage) below which frames will be skipped. Higher values reduce the risk of crackling by causing frames to be dropped more frequently.",
+      NULL,
+      "video",
+      {
+         { "15", NULL },
+         { "18", NULL },
+         { "21", NULL },
+         { "24", NULL },
+         { "27", NULL },
+         { "30", NULL },
+         { "33", NULL },
+         { "36", NULL },
+         { "39", NULL },
+         { "42", NULL },
+         { "45", NULL },
+         { "48", NULL },
+         { "51", NULL },
+         { "54", NULL },
+         { "57", NULL },
+         { "60", NULL },
+         { NULL, NULL },
+      },
+      "33"
+   },
+   {
+      "beetle_saturn_frameskip_interval",
+      "Frameskip Interval",
+      NULL,
+      "Specifies the maximum number of frames that can be skipped before a new frame is rendered; also the number of frames skipped per rendered frame in 'Fixed Interval' mode and while fast-forwarding.",
+      NULL,
+      "video",
+      {
+         { "1", NULL },
+         { "2", NULL },
+         { "3", NULL },
+         { "4", NULL },
+         { "5", NULL },
+         { "6", NULL },
+         { "7", NULL },
+         { "8", NULL },
+         { "9", NULL },
+         { "10", NULL },
+         { NULL, NULL },
+      },
+      "1"
+   },
    {
       "beetle_saturn_multitap_port1",
       "6Player Adaptor on Port 1",
@@ -616,7 +700,7 @@ struct retro_core_option_v2_definition option_defs_us[] = {
       "beetle_saturn_cdimagecache",
       "CD Image Cache (Restart)",
       NULL,
-      "Loads the complete image in memory at startup. Can potentially decrease loading times at the cost of increased startup time. Requires a restart in order for a change to take effect.",
+      "Copies the complete image into memory in the background while the game runs, starting with the area being read, and decodes compressed audio tracks ahead of playback. Can potentially decrease loading times at the cost of memory. Requires a restart in order for a change to take effect.",
       NULL,
       NULL,
       {
@@ -642,6 +726,81 @@ struct retro_core_option_v2_definition option_defs_us[] = {
       },
       "disabled"
    },
+   {
+      "beetle_saturn_idle_skip",
+      "Idle Loop Skipping",
+      NULL,
+      "Skip over iterations of SH-2 busy-wait loops that poll memory until the next interrupt or timer event, instead of emulating them one instruction at a time. Timing is unaffected, but CPU requirements are reduced in games that spend a lot of time waiting.",
+      NULL,
+      NULL,
+      {
+         { "disabled",   NULL },
+         { "enabled",   NULL },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+   {
+      "beetle_saturn_sh2_quantum",
+      "SH-2 Interleave Quantum",
+      NULL,
+      "Let the master SH-2 run ahead of the slave SH-2 by up to this many cycles, instead of switching between them after every instruction. Falls back to exact interleaving around accesses to hardware registers and cache-through work RAM, and during SH-2 DMA; accesses to cartridge RAM, sound RAM and video memory aren't kept in order between the two CPUs. Larger values are faster but may cause timing issues in some games. Has no effect with full CPU cache emulation.",
+      NULL,
+      NULL,
+      {
+         { "lockstep", "Lockstep" },
+         { "64",   NULL },
+         { "128",  NULL },
+         { "256",  NULL },
+         { "512",  NULL },
+         { NULL, NULL },
+      },
+      "lockstep"
+   },
+   {
+      "beetle_saturn_sound_thread",
+      "Sound Thread (Experimental)",
+      NULL,
+      "Emulate the sound CPU and SCSP on a separate host thread, overlapping them with SH-2 emulation while the game has the sound block's interrupt to the main CPU masked. Emulation results are unchanged. Keeps a second host CPU core busy while emulation is running.",
+      NULL,
+      NULL,
+      {
+         { "disabled",   NULL },
+         { "enabled",   NULL },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+   {
+      "beetle_saturn_cd_speed",
+      "CD Access Speed",
+      NULL,
+      "Speed up CD-ROM data reads and seeks by the selected factor, shortening loading times. CD audio always plays at normal speed. Can break games that stream video or audio from the disc; set it back to 1x if a game misbehaves.",
+      NULL,
+      NULL,
+      {
+         { "1x",   "1x (Accurate)" },
+         { "2x",   NULL },
+         { "4x",   NULL },
+         { "8x",   NULL },
+         { NULL, NULL },
+      },
+      "1x"
+   },
+   {
+      "beetle_saturn_lean_memory",
+      "Lean Memory Usage (Restart)",
+      NULL,
+      "Start the video renderer's command queue small and grow it only as needed, instead of reserving its full size up front, and buffer fewer read-ahead sectors when the CD image isn't cached in memory. Reduces memory use, at the cost of brief stalls while it grows. Requires a restart in order for a change to take effect.",
+      NULL,
+      NULL,
+      {
+         { "disabled",   NULL },
+         { "enabled",   NULL },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
    {
       "beetle_saturn_autortc",
       "Automatically set RTC on game load",
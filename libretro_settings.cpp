@@ -15,3 +15,8 @@ bool setting_multitap_port1;
 bool setting_multitap_port2;
 bool opposite_directions;
 bool setting_midsync;
+bool setting_idle_skip;
+int setting_sh2_quantum;
+bool setting_sound_thread;
+unsigned setting_cd_speed_shift;
+bool setting_lean_memory;
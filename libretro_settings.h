@@ -31,5 +31,10 @@ extern bool setting_multitap_port1;
 extern bool setting_multitap_port2;
 extern bool opposite_directions;
 extern bool setting_midsync;
+extern bool setting_idle_skip;
+extern int setting_sh2_quantum;
+extern bool setting_sound_thread;
+extern unsigned setting_cd_speed_shift;
+extern bool setting_lean_memory;
 
 #endif
@@ -0,0 +1,308 @@
+/* Mednafen - Multi-system Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "BackgroundCache.h"
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include <rthreads/rthreads.h>
+
+//
+// One filler thread is shared by all caches, so a CUE sheet with a file per track doesn't hammer the disk with
+// a thread per file.  It works on the cache that missed most recently, otherwise on the oldest one, and exits
+// once everything is filled, detaching itself unless StopCache() has already taken it to join.  StartCache() and
+// StopCache() are only called from the thread that loads and unloads discs.
+//
+struct BackgroundCacheFiller
+{
+ static void Entry(void* data);
+};
+
+static slock* FillerLock = NULL;
+static scond* FillerCond = NULL;
+static sthread* FillerThread = NULL;
+static bool FillerRunning = false;
+static std::vector<BackgroundCache*> FillerQueue;
+static BackgroundCache* FillerCurrent = NULL;
+
+void BackgroundCacheFiller::Entry(void* data)
+{
+ slock_lock(FillerLock);
+ while(FillerQueue.size())
+ {
+  BackgroundCache* bc = FillerQueue.front();
+
+  for(BackgroundCache* q : FillerQueue)
+  {
+   if(q->Hint.load(std::memory_order_relaxed) != BackgroundCache::NoHint)
+   {
+    bc = q;
+    break;
+   }
+  }
+
+  FillerCurrent = bc;
+  slock_unlock(FillerLock);
+
+  const bool done = bc->FillNext();
+
+  slock_lock(FillerLock);
+  FillerCurrent = NULL;
+  scond_broadcast(FillerCond);
+
+  if(done)
+  {
+   // StopCache() may have already removed it.
+   auto it = std::find(FillerQueue.begin(), FillerQueue.end(), bc);
+
+   if(it != FillerQueue.end())
+    FillerQueue.erase(it);
+  }
+ }
+ FillerRunning = false;
+
+ if(FillerThread)
+ {
+  sthread_detach(FillerThread);
+  FillerThread = NULL;
+ }
+ slock_unlock(FillerLock);
+}
+
+BackgroundCache::BackgroundCache() : Data(NULL), BlockSize(0), BlockCount(0), Hint(NoHint), Cursor(0), Remaining(0)
+{
+
+}
+
+BackgroundCache::~BackgroundCache()
+{
+ StopCache();
+}
+
+bool BackgroundCache::StartCache(const uint32 block_size, const uint32 block_count)
+{
+ if(!block_size || !block_count)
+  return false;
+
+ if(!(Data = (uint8*)malloc((size_t)block_size * block_count)))
+ {
+  log_cb(RETRO_LOG_WARN, "Not enough memory to cache disc image(%llu bytes), reading it from disk.\n", (unsigned long long)block_size * block_count);
+  return false;
+ }
+
+ BlockSize = block_size;
+ BlockCount = block_count;
+ Ready.reset(new std::atomic<bool>[block_count]);
+ for(uint32 i = 0; i < block_count; i++)
+  Ready[i].store(false, std::memory_order_relaxed);
+ Hint.store(NoHint, std::memory_order_relaxed);
+ Cursor = 0;
+ Remaining = block_count;
+
+ if(!FillerLock)
+ {
+  FillerLock = slock_new();
+  FillerCond = scond_new();
+ }
+
+ slock_lock(FillerLock);
+ FillerQueue.push_back(this);
+ if(!FillerRunning)
+ {
+  FillerThread = sthread_create(BackgroundCacheFiller::Entry, NULL);
+  FillerRunning = (FillerThread != NULL);
+ }
+ slock_unlock(FillerLock);
+
+ return true;
+}
+
+void BackgroundCache::StopCache(void)
+{
+ if(!Data)
+  return;
+
+ sthread* join_thread = NULL;
+
+ slock_lock(FillerLock);
+ auto it = std::find(FillerQueue.begin(), FillerQueue.end(), this);
+
+ if(it != FillerQueue.end())
+  FillerQueue.erase(it);
+
+ while(FillerCurrent == this)
+  scond_wait(FillerCond, FillerLock);
+
+ if(!FillerQueue.size())
+ {
+  join_thread = FillerThread;
+  FillerThread = NULL;
+ }
+ slock_unlock(FillerLock);
+
+ if(join_thread)
+  sthread_join(join_thread);
+
+ free(Data);
+ Data = NULL;
+ Ready.reset();
+}
+
+// Fills one block; returns true when there's nothing left to do.
+bool BackgroundCache::FillNext(void)
+{
+ const uint32 h = Hint.exchange(NoHint, std::memory_order_relaxed);
+
+ if(h != NoHint)
+  Cursor = h;
+
+ while(Ready[Cursor].load(std::memory_order_relaxed))
+  Cursor = (Cursor + 1 == BlockCount) ? 0 : Cursor + 1;
+
+ if(!FillBlock(Cursor, Data + (size_t)Cursor * BlockSize))
+ {
+  log_cb(RETRO_LOG_ERROR, "Error caching disc image block %u, the rest will be read from disk.\n", Cursor);
+  return true;
+ }
+
+ Ready[Cursor].store(true, std::memory_order_release);
+
+ return !--Remaining;
+}
+
+CachedFileStream::CachedFileStream(const char* path) : position(0), fp_position(0)
+{
+ std::unique_ptr<FileStream> new_fp(new FileStream(path, MODE_READ));
+ fill_fp = new FileStream(path, MODE_READ);
+ fp = new_fp.release();
+ file_size = fp->size();
+
+ if(file_size > 0 && file_size <= ((uint64)65536 << 32))
+  StartCache(65536, (file_size + 65535) >> 16);
+}
+
+CachedFileStream::~CachedFileStream()
+{
+ close();
+}
+
+bool CachedFileStream::FillBlock(const uint32 block, uint8* dest)
+{
+ const uint64 offs = (uint64)block << 16;
+ const uint64 count = std::min<uint64>(65536, file_size - offs);
+
+ fill_fp->seek(offs, SEEK_SET);
+
+ return fill_fp->read(dest, count) == count;
+}
+
+uint64 CachedFileStream::read(void *data, uint64 count)
+{
+ uint8* d = (uint8*)data;
+ uint64 ret = 0;
+
+ if(!fp || position >= file_size)
+  return 0;
+
+ count = std::min<uint64>(count, file_size - position);
+
+ while(count)
+ {
+  const uint32 offs = position & 0xFFFF;
+  const uint64 n = std::min<uint64>(count, 65536 - offs);
+  const uint8* src = CacheStarted() ? GetCachedBlock(position >> 16) : NULL;
+
+  if(src)
+   memcpy(d, src + offs, n);
+  else
+  {
+   if(fp_position != position)
+    fp->seek(position, SEEK_SET);
+
+   const uint64 r = fp->read(d, n);
+
+   fp_position = position + r;
+   if(r != n)
+   {
+    position += r;
+    ret += r;
+    break;
+   }
+  }
+
+  position += n;
+  d += n;
+  ret += n;
+  count -= n;
+ }
+
+ return ret;
+}
+
+void CachedFileStream::write(const void *data, uint64 count)
+{
+ throw MDFN_Error(0, _("Attempt to write to a read-only stream."));
+}
+
+void CachedFileStream::seek(int64 offset, int whence)
+{
+ switch(whence)
+ {
+  case SEEK_SET: position = offset; break;
+  case SEEK_CUR: position += offset; break;
+  case SEEK_END: position = file_size + offset; break;
+ }
+}
+
+uint64 CachedFileStream::tell(void)
+{
+ return position;
+}
+
+void CachedFileStream::truncate(uint64 length)
+{
+ throw MDFN_Error(0, _("Attempt to truncate a read-only stream."));
+}
+
+void CachedFileStream::flush(void)
+{
+
+}
+
+uint64 CachedFileStream::size(void)
+{
+ return file_size;
+}
+
+void CachedFileStream::close(void)
+{
+ StopCache();
+
+ if(fp)
+ {
+  delete fp;
+  fp = NULL;
+ }
+
+ if(fill_fp)
+ {
+  delete fill_fp;
+  fill_fp = NULL;
+ }
+}
@@ -0,0 +1,98 @@
+#ifndef __MDFN_CDROM_BACKGROUNDCACHE_H
+#define __MDFN_CDROM_BACKGROUNDCACHE_H
+
+#include "../mednafen.h"
+#include "../Stream.h"
+#include "../FileStream.h"
+
+#include <atomic>
+#include <memory>
+
+//
+// In-memory copy of a disc image, filled block by block on a shared background thread.  Filling starts at
+// block 0(the boot area), and jumps to wherever the owner last missed, so the cache follows the drive.
+// Blocks that aren't cached yet must be read by the owner from its own handle on the source.
+//
+class BackgroundCache
+{
+ public:
+
+ BackgroundCache();
+ virtual ~BackgroundCache();
+
+ // Allocates the cache and queues it for filling; returns false if there isn't enough memory.
+ bool StartCache(const uint32 block_size, const uint32 block_count);
+
+ // Returns the block if it's cached, otherwise NULL(and the filler continues from this block).
+ INLINE const uint8* GetCachedBlock(const uint32 block)
+ {
+  if(Ready[block].load(std::memory_order_acquire))
+   return Data + (size_t)block * BlockSize;
+
+  if(Hint.load(std::memory_order_relaxed) != block)
+   Hint.store(block, std::memory_order_relaxed);
+
+  return NULL;
+ }
+
+ INLINE bool CacheStarted(void) const { return Data != NULL; }
+
+ protected:
+
+ // Called on the filler thread, so it must only use resources the owner doesn't touch elsewhere.
+ virtual bool FillBlock(const uint32 block, uint8* dest) = 0;
+
+ // Must be called from the derived class' destructor, before anything FillBlock() uses goes away.
+ void StopCache(void);
+
+ private:
+
+ friend struct BackgroundCacheFiller;
+ bool FillNext(void);
+
+ enum : uint32 { NoHint = ~(uint32)0 };
+
+ uint8* Data;
+ uint32 BlockSize;
+ uint32 BlockCount;
+ std::unique_ptr<std::atomic<bool>[]> Ready;
+ std::atomic<uint32> Hint;
+
+ // Only used by the filler thread.
+ uint32 Cursor;
+ uint32 Remaining;
+};
+
+//
+// Read-only file stream backed by a BackgroundCache.
+//
+class CachedFileStream : public Stream, protected BackgroundCache
+{
+ public:
+
+ CachedFileStream(const char* path);
+ virtual ~CachedFileStream();
+
+ virtual uint64 read(void *data, uint64 count);
+ virtual void write(const void *data, uint64 count);
+ virtual void seek(int64 offset, int whence);
+ virtual uint64 tell(void);
+ virtual void truncate(uint64 length);
+ virtual void flush(void);
+ virtual uint64 size(void);
+ virtual void close(void);
+
+ protected:
+
+ virtual bool FillBlock(const uint32 block, uint8* dest);
+
+ private:
+
+ FileStream* fp;	// Used by read() on cache misses.
+ FileStream* fill_fp;	// Used by the filler thread.
+ uint64 file_size;
+ uint64 position;
+ uint64 fp_position;
+};
+
+#endif
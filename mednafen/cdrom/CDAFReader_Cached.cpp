@@ -0,0 +1,155 @@
+/******************************************************************************/
+/* Mednafen - Multi-system Emulator                                           */
+/******************************************************************************/
+/* CDAFReader_Cached.cpp:
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software Foundation, Inc.,
+** 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <mednafen/mednafen.h>
+#include <mednafen/FileStream.h>
+#include "CDAFReader.h"
+#include "CDAFReader_Cached.h"
+#include "BackgroundCache.h"
+
+#include <algorithm>
+
+// One second of CD-DA per cache block.
+static const uint32 FramesPerBlock = 588 * 75;
+
+// Decoded PCM of all open tracks combined; about 25 minutes of CD-DA.
+static const uint64 CacheBudget = (uint64)256 << 20;
+static uint64 CacheUsed = 0;
+
+class CDAFReader_Cached : public CDAFReader, protected BackgroundCache
+{
+   public:
+      CDAFReader_Cached(CDAFReader* reader, Stream* fill_fp, CDAFReader* fill_reader, uint64_t frame_count);
+      ~CDAFReader_Cached();
+
+      uint64_t Read_(int16_t *buffer, uint64_t frames);
+      bool Seek_(uint64_t frame_offset);
+      uint64_t FrameCount(void);
+
+   protected:
+      bool FillBlock(const uint32 block, uint8* dest);
+
+   private:
+      CDAFReader* ar;		// Decodes cache misses.
+      Stream* fill_fw;		// Used by the filler thread.
+      CDAFReader* fill_ar;
+      uint64_t frames_total;
+      uint64_t pos;
+};
+
+CDAFReader_Cached::CDAFReader_Cached(CDAFReader* reader, Stream* fill_fp, CDAFReader* fill_reader, uint64_t frame_count) : ar(reader), fill_fw(fill_fp), fill_ar(fill_reader), frames_total(frame_count), pos(0)
+{
+   if(StartCache(FramesPerBlock * 2 * sizeof(int16_t), (frames_total + FramesPerBlock - 1) / FramesPerBlock))
+      CacheUsed += frames_total * 2 * sizeof(int16_t);
+}
+
+CDAFReader_Cached::~CDAFReader_Cached()
+{
+   if(CacheStarted())
+      CacheUsed -= frames_total * 2 * sizeof(int16_t);
+
+   StopCache();
+
+   delete fill_ar;
+   delete fill_fw;
+   delete ar;
+}
+
+bool CDAFReader_Cached::FillBlock(const uint32 block, uint8* dest)
+{
+   const uint64_t offset = (uint64_t)block * FramesPerBlock;
+   const uint64_t count = std::min<uint64_t>(FramesPerBlock, frames_total - offset);
+
+   return fill_ar->Read(offset, (int16_t*)dest, count) == count;
+}
+
+uint64_t CDAFReader_Cached::Read_(int16_t *buffer, uint64_t frames)
+{
+   uint64_t ret = 0;
+
+   frames = std::min<uint64_t>(frames, (pos < frames_total) ? frames_total - pos : 0);
+
+   while(frames)
+   {
+      const uint32 offs = pos % FramesPerBlock;
+      const uint64_t n = std::min<uint64_t>(frames, FramesPerBlock - offs);
+      const uint8* src = CacheStarted() ? GetCachedBlock(pos / FramesPerBlock) : NULL;
+
+      if(src)
+         memcpy(buffer, src + offs * 2 * sizeof(int16_t), n * 2 * sizeof(int16_t));
+      else
+      {
+         const uint64_t r = ar->Read(pos, buffer, n);
+
+         if(r != n)
+         {
+            pos += r;
+            return ret + r;
+         }
+      }
+
+      pos += n;
+      buffer += n * 2;
+      ret += n;
+      frames -= n;
+   }
+
+   return ret;
+}
+
+bool CDAFReader_Cached::Seek_(uint64_t frame_offset)
+{
+   pos = frame_offset;
+   return(true);
+}
+
+uint64_t CDAFReader_Cached::FrameCount(void)
+{
+   return frames_total;
+}
+
+CDAFReader* CDAFR_Cached_Open(CDAFReader* reader, const std::string& path)
+{
+   const uint64_t frame_count = reader->FrameCount();
+   Stream* fill_fp = NULL;
+   CDAFReader* fill_reader = NULL;
+
+   if(!frame_count || (CacheUsed + frame_count * 2 * sizeof(int16_t)) > CacheBudget)
+      return reader;
+
+   try
+   {
+      fill_fp = new FileStream(path.c_str(), MODE_READ);
+      fill_reader = CDAFR_Open(fill_fp);
+   }
+   catch(...)
+   {
+      delete fill_fp;
+      return reader;
+   }
+
+   if(!fill_reader)
+   {
+      delete fill_fp;
+      return reader;
+   }
+
+   return new CDAFReader_Cached(reader, fill_fp, fill_reader, frame_count);
+}
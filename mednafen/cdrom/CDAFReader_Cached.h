@@ -0,0 +1,30 @@
+/******************************************************************************/
+/* Mednafen - Multi-system Emulator                                           */
+/******************************************************************************/
+/* CDAFReader_Cached.h:
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software Foundation, Inc.,
+** 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef __MDFN_CDAFREADER_CACHED_H
+#define __MDFN_CDAFREADER_CACHED_H
+
+#include <string>
+
+// Wraps "reader"(which it takes ownership of) so the whole track is decoded to PCM in the background, using a second
+// decoder on its own handle to "path".  Returns "reader" unchanged if the track doesn't fit in the PCM cache budget.
+CDAFReader* CDAFR_Cached_Open(CDAFReader* reader, const std::string& path);
+
+#endif
@@ -23,6 +23,7 @@
 #include <mednafen/general.h>
 
 #include "CDAccess_CCD.h"
+#include "BackgroundCache.h"
 
 #include <limits>
 #include <limits.h>
@@ -263,7 +264,7 @@ bool CDAccess_CCD::Load(const std::string& path, bool image_memcache)
       std::string image_path = MDFN_EvalFIP(dir_path, file_base + std::string(".") + std::string(img_extsd), true);
 
       if(image_memcache)
-         img_stream = new MemoryStream(new FileStream(image_path.c_str(), MODE_READ));
+         img_stream = new CachedFileStream(image_path.c_str());
       else
          img_stream = new FileStream(image_path.c_str(), MODE_READ);
 
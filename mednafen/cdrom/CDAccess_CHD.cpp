@@ -52,7 +52,7 @@ static const int32_t DI_Size_Table[8] =
         2352  // CD-I RAW
 };
 
-CDAccess_CHD::CDAccess_CHD(const std::string &path, bool image_memcache) : NumTracks(0), total_sectors(0)
+CDAccess_CHD::CDAccess_CHD(const std::string &path, bool image_memcache) : NumTracks(0), total_sectors(0), chd(NULL), fill_chd(NULL), hunkmem(NULL)
 {
   Load(path, image_memcache);
 }
@@ -66,20 +66,23 @@ bool CDAccess_CHD::Load(const std::string &path, bool image_memcache)
     return false;
   }
 
+  /* allocate storage for sector reads */
+  const chd_header *head = chd_get_header(chd);
+  hunkmem = (uint8_t *)malloc(head->hunkbytes);
+  oldhunk = -1;
+
+  /* decompressed hunks are cached in the background, through a handle of their own */
   if (image_memcache)
   {
-    if ((err = chd_precache(chd)) != CHDERR_NONE)
+    if (chd_open(path.c_str(), CHD_OPEN_READ, NULL, &fill_chd) != CHDERR_NONE)
+      log_cb(RETRO_LOG_ERROR, "Failed to open CHD image for caching: %s\n", path.c_str());
+    else if (!StartCache(head->hunkbytes, head->totalhunks))
     {
-      log_cb(RETRO_LOG_ERROR, "Failed to pre-cache CHD image: %s", path.c_str());
-      return false;
+      chd_close(fill_chd);
+      fill_chd = NULL;
     }
   }
 
-  /* allocate storage for sector reads */
-  const chd_header *head = chd_get_header(chd);
-  hunkmem = (uint8_t *)malloc(head->hunkbytes);
-  oldhunk = -1;
-
   log_cb(RETRO_LOG_INFO, "chd_load '%s' hunkbytes=%d\n", path.c_str(), head->hunkbytes);
 
   int plba = -150;
@@ -203,6 +206,11 @@ bool CDAccess_CHD::Load(const std::string &path, bool image_memcache)
 
 CDAccess_CHD::~CDAccess_CHD()
 {
+  StopCache();
+
+  if (fill_chd != NULL)
+    chd_close(fill_chd);
+
   if (chd != NULL)
     chd_close(chd);
 
@@ -210,28 +218,46 @@ CDAccess_CHD::~CDAccess_CHD()
     free(hunkmem);
 }
 
-bool CDAccess_CHD::Read_CHD_Hunk_RAW(uint8_t *buf, int32_t lba)
+bool CDAccess_CHD::FillBlock(const uint32 block, uint8* dest)
 {
-  const chd_header *head = chd_get_header(chd);
-  int cad = lba; // HACK - track->file_offset;
-  int sph = head->hunkbytes / (2352 + 96);
-  int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
-  int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
-  int err = CHDERR_NONE;
+  return chd_read(fill_chd, block, dest) == CHDERR_NONE;
+}
+
+const uint8_t *CDAccess_CHD::ReadHunk(int hunknum, int32_t lba)
+{
+  if (CacheStarted())
+  {
+    const uint8_t *hunk = GetCachedBlock(hunknum);
+
+    if (hunk)
+      return hunk;
+  }
 
   /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
   if (hunknum != oldhunk)
   {
-    err = chd_read(chd, hunknum, hunkmem);
+    int err = chd_read(chd, hunknum, hunkmem);
     if (err != CHDERR_NONE)
       log_cb(RETRO_LOG_ERROR, "chd_read_sector failed lba=%d error=%d\n", lba, err);
     else
       oldhunk = hunknum;
   }
 
-  memcpy(buf, hunkmem + hunkofs * (2352 + 96), 2352);
+  return hunkmem;
+}
 
-  return err;
+bool CDAccess_CHD::Read_CHD_Hunk_RAW(uint8_t *buf, int32_t lba)
+{
+  const chd_header *head = chd_get_header(chd);
+  int cad = lba; // HACK - track->file_offset;
+  int sph = head->hunkbytes / (2352 + 96);
+  int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
+  int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
+  const uint8_t *hunk = ReadHunk(hunknum, lba);
+
+  memcpy(buf, hunk + hunkofs * (2352 + 96), 2352);
+
+  return true;
 }
 
 bool CDAccess_CHD::Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba)
@@ -241,21 +267,11 @@ bool CDAccess_CHD::Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba)
   int sph = head->hunkbytes / (2352 + 96);
   int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
   int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
-  int err = CHDERR_NONE;
+  const uint8_t *hunk = ReadHunk(hunknum, lba);
 
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
-  {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-      log_cb(RETRO_LOG_ERROR, "chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
-  }
-
-  memcpy(buf + 16, hunkmem + hunkofs * (2352 + 96), 2048);
+  memcpy(buf + 16, hunk + hunkofs * (2352 + 96), 2048);
 
-  return err;
+  return true;
 }
 
 bool CDAccess_CHD::Read_CHD_Hunk_M2(uint8_t *buf, int32_t lba)
@@ -265,21 +281,11 @@ bool CDAccess_CHD::Read_CHD_Hunk_M2(uint8_t *buf, int32_t lba)
   int sph = head->hunkbytes / (2352 + 96);
   int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
   int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
-  int err = CHDERR_NONE;
+  const uint8_t *hunk = ReadHunk(hunknum, lba);
 
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
-  {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-      log_cb(RETRO_LOG_ERROR, "chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
-  }
-
-  memcpy(buf + 16, hunkmem + hunkofs * (2352 + 96), 2336);
+  memcpy(buf + 16, hunk + hunkofs * (2352 + 96), 2336);
 
-  return err;
+  return true;
 }
 
 bool CDAccess_CHD::Read_Raw_Sector(uint8_t *buf, int32_t lba)
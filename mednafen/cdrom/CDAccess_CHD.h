@@ -23,6 +23,7 @@
 #include <mednafen/MemoryStream.h>
 
 #include "CDAccess.h"
+#include "BackgroundCache.h"
 #include "chd.h"
 
 struct CHDFILE_TRACK_INFO
@@ -49,7 +50,7 @@ struct CHDFILE_TRACK_INFO
 
 };
 
-class CDAccess_CHD : public CDAccess
+class CDAccess_CHD : public CDAccess, protected BackgroundCache
 {
  public:
 
@@ -67,6 +68,10 @@ class CDAccess_CHD : public CDAccess
  bool Load(const std::string& path, bool image_memcache);
  void Cleanup(void);
 
+ // Caches decompressed hunks, read through fill_chd.
+ virtual bool FillBlock(const uint32 block, uint8* dest);
+ const uint8_t* ReadHunk(int hunknum, int32_t lba);
+
   // MakeSubPQ will OR the simulated P and Q subchannel data into SubPWBuf.
   int32_t MakeSubPQ(int32_t lba, uint8_t *SubPWBuf) const;
 
@@ -89,6 +94,7 @@ class CDAccess_CHD : public CDAccess
   int num_tracks;
 
   chd_file *chd;
+  chd_file *fill_chd;
   /* hunk data cache */
   uint8_t *hunkmem;
   /* last hunknum read */
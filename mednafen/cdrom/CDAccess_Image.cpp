@@ -46,8 +46,10 @@
 
 #include "CDAccess.h"
 #include "CDAccess_Image.h"
+#include "BackgroundCache.h"
 
 #include "CDAFReader.h"
+#include "CDAFReader_Cached.h"
 
 #include <map>
 
@@ -219,7 +221,7 @@ bool CDAccess_Image::ParseTOCFileLineInfo(CDRFILE_TRACK_INFO *track, const int t
       efn = MDFN_EvalFIP(base_dir, filename);
 
       if(image_memcache)
-         track->fp = new MemoryStream(new FileStream(efn.c_str(), MODE_READ));
+         track->fp = new CachedFileStream(efn.c_str());
       else
          track->fp = new FileStream(efn.c_str(), MODE_READ);
 
@@ -687,11 +689,11 @@ bool CDAccess_Image::ImageOpen(const std::string& path, bool image_memcache)
 	    else
 		    efn = args[0];
 
-            TmpTrack.fp = new FileStream(efn.c_str(), MODE_READ);
-            TmpTrack.FirstFileInstance = 1;
-
             if(image_memcache)
-               TmpTrack.fp = new MemoryStream(TmpTrack.fp);
+               TmpTrack.fp = new CachedFileStream(efn.c_str());
+            else
+               TmpTrack.fp = new FileStream(efn.c_str(), MODE_READ);
+            TmpTrack.FirstFileInstance = 1;
 
             if(!strcasecmp(args[1].c_str(), "BINARY"))
             {
@@ -713,6 +715,9 @@ bool CDAccess_Image::ImageOpen(const std::string& path, bool image_memcache)
                   log_cb(RETRO_LOG_ERROR, "Unsupported audio track file format: %s\n", args[0].c_str());
                   return false;
                }
+
+               if(image_memcache)
+                  TmpTrack.AReader = CDAFR_Cached_Open(TmpTrack.AReader, efn);
             }
             else
             {
@@ -89,7 +89,7 @@ class CDIF_MT : public CDIF
 {
    public:
 
-      CDIF_MT(CDAccess *cda);
+      CDIF_MT(CDAccess *cda, bool lean);
       virtual ~CDIF_MT();
 
       virtual void HintReadSector(int32_t lba);
@@ -112,8 +112,11 @@ class CDIF_MT : public CDIF
       CDIF_Queue EmuThreadQueue;
 
 
-      enum { SBSize = 256 };
-      CDIF_Sector_Buffer SectorBuffers[SBSize];
+      // Must be more than 4 times the read thread's maximum read-ahead.
+      enum { SBSizeNormal = 256 };
+      enum { SBSizeLean = 80 };
+      const int SBSize;
+      CDIF_Sector_Buffer *SectorBuffers;
 
       uint32_t SBWritePos;
 
@@ -348,11 +351,13 @@ int CDIF_MT::ReadThreadStart()
    return(1);
 }
 
-CDIF_MT::CDIF_MT(CDAccess *cda) : disc_cdaccess(cda), CDReadThread(NULL), SBMutex(NULL), SBCond(NULL)
+CDIF_MT::CDIF_MT(CDAccess *cda, bool lean) : disc_cdaccess(cda), CDReadThread(NULL), SBSize(lean ? SBSizeLean : SBSizeNormal), SectorBuffers(NULL), SBMutex(NULL), SBCond(NULL)
 {
    CDIF_Message msg;
    RTS_Args s;
 
+   SectorBuffers      = new CDIF_Sector_Buffer[SBSize];
+
    SBMutex            = slock_new();
    SBCond             = scond_new();
 
@@ -386,6 +391,8 @@ CDIF_MT::~CDIF_MT()
 
    if (disc_cdaccess)
       delete disc_cdaccess;
+
+   delete[] SectorBuffers;
 }
 
 bool CDIF::ValidateRawSector(uint8_t *buf)
@@ -567,11 +574,11 @@ bool CDIF_ST::ReadRawSectorPWOnly(uint8_t* pwbuf, int32_t lba, bool hint_fullrea
    }
 }
 
-CDIF *CDIF_Open(const std::string& path, bool image_memcache)
+CDIF *CDIF_Open(const std::string& path, bool image_memcache, bool lean)
 {
    CDAccess *cda = CDAccess_Open(path, image_memcache);
 
    if(!image_memcache)
-      return new CDIF_MT(cda);
+      return new CDIF_MT(cda, lean);
    return new CDIF_ST(cda);
 }
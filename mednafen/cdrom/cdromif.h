@@ -54,6 +54,7 @@ class CDIF
  TOC disc_toc;
 };
 
-CDIF *CDIF_Open(const std::string& path, bool image_memcache);
+// With "lean", the read-ahead thread(when the image isn't cached in memory) keeps fewer sectors buffered.
+CDIF *CDIF_Open(const std::string& path, bool image_memcache, bool lean);
 
 #endif
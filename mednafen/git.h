@@ -296,6 +296,11 @@ struct EmulateSpecStruct
 	// The framebuffer pointed to by surface->pixels is written to by the system emulation code.
 	MDFN_Surface* surface = nullptr;
 
+	// Optional, set by the driver code when "surface" may be too small for the frame(e.g. a frontend-provided framebuffer
+	// sized to the previous frame).  If a line doesn't fit, the emulation code copies what it has drawn so far into this
+	// surface and points "surface" at it for the rest of the frame.
+	MDFN_Surface* fallback_surface = nullptr;
+
 	// Set by the system emulation code every frame, to denote the horizontal and vertical offsets of the image, and the size
 	// of the image.  If the emulated system sets the elements of LineWidths, then the width(w) of this structure
 	// is ignored while drawing the image.
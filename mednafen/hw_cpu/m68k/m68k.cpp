@@ -63,9 +63,25 @@ M68K::M68K(const bool rev_e) : Revision_E(rev_e),
  timestamp = 0;
  XPending = 0;
  IPL = 0;
+
+ memset(FastMap, 0, sizeof(FastMap));
+ FastMapCycles = 4;
+ FastMapReadLimit = 0;
+
  Reset(true);
 }
 
+void M68K::SetFastMap(uint32 Astart, uint32 Aend, const uint16* ptr, uint32 length)
+{
+ const uint32 Abound = Aend + 1;
+
+ assert(!(Astart & 0xFFFF) && !(Abound & 0xFFFF) && !(length & 0xFFFF));
+ assert(Abound <= 0x1000000);
+
+ for(uint32 A = Astart; A < Abound; A += 0x10000)
+  FastMap[A >> 16] = ptr ? ((uintptr_t)ptr + ((A - Astart) % length) - A) : 0;
+}
+
 M68K::~M68K()
 {
 
@@ -168,6 +184,20 @@ void M68K::SetExtHalted(bool state)
   XPending |= XPENDING_MASK_EXTHALTED;
 }
 
+template<typename T>
+INLINE T M68K::ReadBus(uint32 addr)
+{
+ const uintptr_t fmp = FastMap[(addr >> 16) & 0xFF];
+
+ if(MDFN_LIKELY(fmp && !(addr & (sizeof(T) - 1)) && (timestamp + FastMapCycles) <= FastMapReadLimit))
+ {
+  timestamp += FastMapCycles;
+  return ne16_rbo_be<T>(fmp, addr & 0xFFFFFF);
+ }
+
+ return (sizeof(T) == 2) ? BusRead16(addr) : BusRead8(addr);
+}
+
 template<typename T>
 INLINE T M68K::Read(uint32 addr)
 {
@@ -175,22 +205,28 @@ INLINE T M68K::Read(uint32 addr)
  {
   uint32 ret;
 
-  ret = BusRead16(addr) << 16;
-  ret |= BusRead16(addr + 2);
+  ret = ReadBus<uint16>(addr) << 16;
+  ret |= ReadBus<uint16>(addr + 2);
 
   return ret;
  }
- else if(sizeof(T) == 2)
-  return BusRead16(addr);
  else
-  return BusRead8(addr);
+  return ReadBus<T>(addr);
 }
 
 INLINE uint16 M68K::ReadOp(void)
 {
+ const uintptr_t fmp = FastMap[(PC >> 16) & 0xFF];
  uint16 ret;
 
- ret = BusReadInstr(PC);
+ if(MDFN_LIKELY(fmp && !(PC & 1)))
+ {
+  timestamp += FastMapCycles;
+  ret = ne16_rbo_be<uint16>(fmp, PC & 0xFFFFFF);
+ }
+ else
+  ret = BusReadInstr(PC);
+
  PC += 2;
 
  return ret;
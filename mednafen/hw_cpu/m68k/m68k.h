@@ -115,6 +115,9 @@ class M68K
  //private:
  void RecalcInt(void);
 
+ template<typename T>
+ T ReadBus(uint32 addr);
+
  template<typename T>
  T Read(uint32 addr);
 
@@ -469,6 +472,20 @@ static uint8 TAS_Callback(uint8 data)
  unsigned (MDFN_FASTCALL *BusIntAck)(uint8 level);
  void (MDFN_FASTCALL *BusRESET)(bool state);	// Optional; Calling Reset(false) from this callback *is* permitted.
 
+ //
+ // Optional direct-read map, one entry per 64KiB page of the 24-bit address space; 0 to go through the callbacks
+ // above, otherwise the host pointer minus the page's base address(big-endian 16-bit units, like the SH-2 fast map).
+ //
+ // Mapped instruction fetches and 8/16-bit reads add FastMapCycles to timestamp instead of calling BusReadInstr()/
+ // BusRead8()/BusRead16().  Data reads only take the direct path while timestamp + FastMapCycles <= FastMapReadLimit,
+ // so the host's bus read callbacks still see any synchronization point they check for.
+ //
+ void SetFastMap(uint32 Astart, uint32 Aend, const uint16* ptr, uint32 length);
+
+ uintptr_t FastMap[256];
+ int32 FastMapCycles;
+ int32 FastMapReadLimit;
+
  //
  //
  //
@@ -127,6 +127,8 @@ void CART_AR4MP_Init(CartInfo* c, RFILE* str)
 
  FLASH = new_FLASH.get();
  ExtRAM = new_ExtRAM.get();
+ SS_RegisterMemoryRegion("Cart", FLASH, 0x40000);
+ SS_RegisterMemoryRegion("Cart", ExtRAM, 0x400000);
  //
  //
  filestream_read(str, FLASH, 0x40000);
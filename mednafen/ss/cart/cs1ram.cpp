@@ -65,6 +65,7 @@ static MDFN_COLD void StateAction(StateMem* sm, const unsigned load, const bool
 void CART_CS1RAM_Init(CartInfo* c)
 {
  CS1RAM = new uint16[0x1000000 / sizeof(uint16)];
+ SS_RegisterMemoryRegion("Cart", CS1RAM, 0x1000000);
 
  SS_SetPhysMemMap   (0x04000000, 0x04FFFFFF, CS1RAM, 0x1000000, true);
  c->CS01_SetRW8W16(0x04000000, 0x04FFFFFF, 
@@ -22,7 +22,7 @@
 #include "common.h"
 #include "extram.h"
 
-static uint16 ExtRAM[0x200000];
+static uint16* ExtRAM = nullptr;
 static size_t ExtRAM_Mask;
 static uint8 Cart_ID;
 
@@ -49,7 +49,16 @@ static MDFN_HOT void CartID_Read_DB(uint32 A, uint16* DB)
 static MDFN_COLD void Reset(bool powering_up)
 {
  if(powering_up)
-  memset(ExtRAM, 0, sizeof(ExtRAM));	// TODO: Test.
+  memset(ExtRAM, 0, 0x400000);	// TODO: Test.
+}
+
+static MDFN_COLD void Kill(void)
+{
+ if(ExtRAM)
+ {
+  delete[] ExtRAM;
+  ExtRAM = nullptr;
+ }
 }
 
 static MDFN_COLD void StateAction(StateMem* sm, const unsigned load, const bool data_only)
@@ -68,6 +77,9 @@ static MDFN_COLD void StateAction(StateMem* sm, const unsigned load, const bool
 
 void CART_ExtRAM_Init(CartInfo* c, bool R4MiB)
 {
+ ExtRAM = new uint16[0x400000 / sizeof(uint16)];
+ SS_RegisterMemoryRegion("Cart", ExtRAM, 0x400000);
+
  if(R4MiB)
  {
   Cart_ID = 0x5C;
@@ -90,5 +102,6 @@ void CART_ExtRAM_Init(CartInfo* c, bool R4MiB)
  c->CS01_SetRW8W16(/*0x04FFFFFE*/0x04F00000, 0x04FFFFFF, CartID_Read_DB);
 
  c->Reset = Reset;
+ c->Kill = Kill;
  c->StateAction = StateAction;
 }
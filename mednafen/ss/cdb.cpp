@@ -404,6 +404,7 @@ enum
 };
 static int64 DriveCounter;
 static int64 PeriodicIdleCounter;
+static unsigned FastCDShift;	// Data sector delivery and seek delays are divided by (1 << FastCDShift).
 enum : int64 { PeriodicIdleCounter_Reload = (int64)187065 << 32 };
 
 static int32 PauseCounter;
@@ -1184,6 +1185,12 @@ void CDB_SetClockRatio(uint32 ratio)
  CDB_ClockRatio = ratio;
 }
 
+// Not saved in save states; takes effect at the next drive counter reload.
+void CDB_SetFastCD(unsigned speed_shift)
+{
+ FastCDShift = speed_shift;
+}
+
 static void SWReset(void)
 {
  GetSecLen = SECLEN_2048;
@@ -1253,6 +1260,8 @@ void CDB_SetCDActive(bool active)	// TODO
 
 void CDB_Init(void)
 {
+ SS_RegisterMemoryRegion("CD block", Buffers, sizeof(Buffers));
+
  lastts = 0;
  Cur_CDIF = NULL;
  TrayOpen = false;
@@ -1288,6 +1297,8 @@ static INLINE void RecalcIRQOut(void)
 
 void CDB_Reset(bool powering_up)
 {
+ SOUND_Sync();	// CD-DA buffer is consumed by the sound block.
+
  if(powering_up)
  {
   //
@@ -1643,6 +1654,15 @@ static void BasicResults(uint32 res0, uint32 res1, uint32 res2, uint32 res3)
 //
 enum : int32 { SeekCPIUpdateDelay = 500 };
 
+// Time to the next sector at the current position; CD-DA is always delivered at normal speed, for correct playback.
+static INLINE int32 SectorPeriod(void)
+{
+ if(SubQBuf_Safe[0] & 0x40)
+  return ((44100 * 256) / 150) >> FastCDShift;
+
+ return (44100 * 256) / 75;
+}
+
 static void SeekStart1(void)
 {
  if(CurPlayStart & 0x800000)
@@ -1704,7 +1724,7 @@ static void SeekStart2(int delay_sub = 0)
 
  Cur_CDIF->HintReadSector(CurPosInfo.fad - 150);
 
- DriveCounter = (int64)(256000 - delay_sub) << 32;
+ DriveCounter = (int64)((256000 >> FastCDShift) - delay_sub) << 32;
  SeekIndexPhase = 0;
 }
 
@@ -1845,6 +1865,8 @@ static void CheckBufPauseResume(void)
 template<unsigned sample_shift = 0>
 static INLINE void BufferCDDA(const uint8* inbuf)
 {
+ SOUND_Sync();
+
  if(!CDDABuf_Count)
  {
   for(int i = 0; i < CDDABuf_PrefillCount; i++)
@@ -1953,7 +1975,7 @@ static void Drive_Run(int64 clocks)
 
 	 CurPosInfo.status = STATUS_SEEK;
 	 DrivePhase = DRIVEPHASE_SEEK;
-	 DriveCounter += (int64)seek_time << 32;
+	 DriveCounter += (int64)(seek_time >> FastCDShift) << 32;
 	 CurSector = CurPosInfo.fad;
 	 SubQBuf_Safe_Valid = false;
 	}
@@ -1974,7 +1996,7 @@ static void Drive_Run(int64 clocks)
 	 if(!SubQBuf_Safe_Valid)
          {
 	  CurSector++;
-	  DriveCounter += (int64)((44100 * 256) / 150) << 32;
+	  DriveCounter += (int64)(((44100 * 256) / 150) >> FastCDShift) << 32;
          }
 	 else
 	 {
@@ -1996,13 +2018,13 @@ static void Drive_Run(int64 clocks)
 	    {
 	     index_ok = false;
 	     CurSector += 4;
-	     DriveCounter += (int64)((44100 * 256) / 150) << 32;
+	     DriveCounter += (int64)(((44100 * 256) / 150) >> FastCDShift) << 32;
 	    }
 	    else
 	    {
 	     index_ok = false;
 	     CurSector += 128;
-	     DriveCounter += (int64)((44100 * 256) / 150) << 32;
+	     DriveCounter += (int64)(((44100 * 256) / 150) >> FastCDShift) << 32;
 	     SeekIndexPhase = 1;
 	    }
 	   }
@@ -2012,7 +2034,7 @@ static void Drive_Run(int64 clocks)
 	    {
 	     index_ok = false;
 	     CurSector -= 124;
-	     DriveCounter += (int64)((44100 * 256) / 150) << 32;
+	     DriveCounter += (int64)(((44100 * 256) / 150) >> FastCDShift) << 32;
 	     SeekIndexPhase = 2;
 	    }
 	   }
@@ -2022,7 +2044,7 @@ static void Drive_Run(int64 clocks)
 	  {
 	   PlaySectorProcessed = false;
 	   DrivePhase = DRIVEPHASE_PLAY;
-	   DriveCounter += (int64)((44100 * 256) / ((SubQBuf_Safe[0] & 0x40) ? 150 : 75)) << 32;
+	   DriveCounter += (int64)SectorPeriod() << 32;
 
 #if 0
 	   if(!Cur_CDIF->NonDeterministic_CheckSectorReady(CurSector - 150))
@@ -2126,7 +2148,7 @@ static void Drive_Run(int64 clocks)
 	 }
 	}
 
-	DriveCounter += (int64)((44100 * 256) / ((SubQBuf_Safe[0] & 0x40) ? 150 : 75)) << 32;
+	DriveCounter += (int64)SectorPeriod() << 32;
 	break;
    }
   }
@@ -2267,6 +2289,8 @@ void CDB_GetCDDA(uint16* outbuf)
 
 static void ClearPendingSec(void)
 {
+ SOUND_Sync();
+
  //PlayEndIRQPending = 0;
  PlayEndIRQType = 0;
 
@@ -3756,6 +3780,7 @@ sscpu_timestamp_t CDB_Update(sscpu_timestamp_t timestamp)
     CurPosInfo.idx = 0xFF;
     CurPosInfo.tno = 0xFF;
 
+    SOUND_Sync();
     CDDABuf_WP = 0;
     CDDABuf_RP = 0;
     CDDABuf_Count = 0;
@@ -3846,6 +3871,60 @@ uint16 CDB_Read(uint32 offset)
  return ret;
 }
 
+//
+// Equivalent to 'count' CDB_Read(0) calls, for DMA from the data transfer port.  While the FIFO is empty, spans of
+// sector data are taken straight from the buffer instead of being passed through the FIFO one word at a time.
+//
+void CDB_ReadDataBurst(uint16* dest, uint32 count)
+{
+ const unsigned fifo_size = sizeof(DT.FIFO) / sizeof(DT.FIFO[0]);
+
+ while(count)
+ {
+  if(DT.Active && !DT.Writing && DT.InBufCounter > 0 && !DT.FIFO_In && DT.FIFO_RP == DT.FIFO_WP && DT.BufList[DT.CurBufIndex] < 0xF0)
+  {
+   const uint8* src = &Buffers[DT.BufList[DT.CurBufIndex]].Data[DT.InBufOffs << 1];
+   const uint32 n = std::min<uint32>(count, DT.InBufCounter);
+
+   for(uint32 i = 0; i < n; i++)
+    dest[i] = MDFN_de16msb(&src[i << 1]);
+
+   // Leave the same(stale) FIFO contents behind as DT_ReadIntoFIFO() would have.
+   const uint32 skip = (n > fifo_size) ? (n - fifo_size) : 0;
+
+   DT.FIFO_WP = (DT.FIFO_WP + skip) % fifo_size;
+   for(uint32 i = skip; i < n; i++)
+   {
+    DT.FIFO[DT.FIFO_WP] = dest[i];
+    DT.FIFO_WP = (DT.FIFO_WP + 1) % fifo_size;
+   }
+   DT.FIFO_RP = DT.FIFO_WP;
+
+   DT.InBufOffs += n;
+   DT.InBufCounter -= n;
+   DT.TotalCounter += n;
+
+   if(!DT.InBufCounter)
+   {
+    DT.CurBufIndex++;
+    if(DT.CurBufIndex < DT.BufCount)
+    {
+     DT_SetIBOffsCount(Buffers[DT.BufList[DT.CurBufIndex]].Data);
+    }
+   }
+
+   dest += n;
+   count -= n;
+  }
+  else
+  {
+   *dest = CDB_Read(0);
+   dest++;
+   count--;
+  }
+ }
+}
+
 void CDB_Write_DBM(uint32 offset, uint16 DB, uint16 mask)
 {
  sscpu_timestamp_t nt = CDB_Update(SH7095_mem_timestamp);
@@ -3921,6 +4000,8 @@ void CDB_Write_DBM(uint32 offset, uint16 DB, uint16 mask)
 
 void CDB_StateAction(StateMem* sm, const unsigned load, const bool data_only)
 {
+ SOUND_Sync();
+
  SFORMAT StateRegs[] =
  {
   SFVAR(GetSecLen),
@@ -33,6 +33,7 @@ void CDB_SetDisc(bool tray_open, CDIF *cdif) MDFN_COLD;
 
 void CDB_Write_DBM(uint32 offset, uint16 DB, uint16 mask) MDFN_HOT;
 uint16 CDB_Read(uint32 offset) MDFN_HOT;
+void CDB_ReadDataBurst(uint16* dest, uint32 count) MDFN_HOT;
 
 void CDB_Reset(bool powering_up) MDFN_COLD;
 
@@ -43,6 +44,7 @@ void CDB_GetCDDA(uint16* outbuf);	// writes to outbuf[0] and outbuf[1]
 
 
 void CDB_SetClockRatio(uint32 ratio);
+void CDB_SetFastCD(unsigned speed_shift);	// 0 = real drive speed, 1 = 2x, 2 = 4x, 3 = 8x
 void CDB_ResetCD(void);
 void CDB_SetCDActive(bool active);
 
@@ -453,6 +453,9 @@ static const struct
  // Still random hangs...wtf is this game doing...
  { "T-6006G", HORRIBLEHACK_NOSH2DMALINE106 | HORRIBLEHACK_VDP1INSTANT, "Thunderhawk II (Japan)", gettext_noop("Fixes hangs just before and during gameplay.") },
  { "T-11501H00", HORRIBLEHACK_NOSH2DMALINE106 | HORRIBLEHACK_VDP1INSTANT, "Thunderstrike II (USA)", gettext_noop("Fixes hangs just before and during gameplay.") },
+
+ { "GS-9079", HORRIBLEHACK_EXACTSH2INTERLEAVE,	"Virtua Fighter 2 (Japan)", gettext_noop("Master and slave SH-2 exchange work every frame through shared memory.") },
+ { "MK-81014", HORRIBLEHACK_EXACTSH2INTERLEAVE,	"Virtua Fighter 2 (USA)", gettext_noop("Master and slave SH-2 exchange work every frame through shared memory.") },
 };
 
 uint32 DB_LookupHH(const char* sgid, const uint8* fd_id)
@@ -495,6 +498,9 @@ std::string DB_GetHHDescriptions(const uint32 hhv)
  if(hhv & HORRIBLEHACK_VDP1INSTANT)
   sv += "Execute VDP1 commands instantly. ";
 
+ if(hhv & HORRIBLEHACK_EXACTSH2INTERLEAVE)
+  sv += "Always interleave master and slave SH-2 execution exactly, ignoring the quantum setting. ";
+
 /*
  if(hhv & HORRIBLEHACK_SCUINTDELAY)
   sv += "Delay SCU interrupt generation after a write to SCU IMS unmasks a pending interrupt. ";
@@ -49,6 +49,7 @@ enum
 void SCU_Reset(bool powering_up) MDFN_COLD;
 
 void SCU_SetInt(unsigned which, bool active);
+bool SCU_CanDeferInt(unsigned which);
 int32 SCU_SetHBVB(int32 pclocks, bool hblank_in, bool vblank_in);
 
 bool SCU_CheckVDP1HaltKludge(void);
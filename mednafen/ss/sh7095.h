@@ -71,6 +71,18 @@ class SH7095 final
  NO_CLONE NO_INLINE void RunSlaveUntil(sscpu_timestamp_t bound_timestamp) MDFN_HOT;
  NO_CLONE NO_INLINE void RunSlaveUntil_Debug(sscpu_timestamp_t bound_timestamp) MDFN_COLD;
 
+ // Busy-wait loop detection
+ bool IdleLoop_BodyIsPure(const uint32 head, const uint32 last);
+
+ // True if the last instruction executed was a taken delayed branch, so the next one is its delay slot(at
+ // PC - 4 is then the branch target, not the next instruction).
+ INLINE bool IdleLoop_InDelaySlot(void) const
+ {
+  const uint8 op = Pipe_ID >> 24;
+
+  return op >= 0x80 && op < 0xFE;
+ }
+
  //private:
  uint32 R[16];
  uint32 PC;
@@ -28,6 +28,9 @@
 #include "../hw_cpu/m68k/m68k.h"
 #include "../jump.h"
 
+#include <atomic>
+#include <rthreads/rthreads.h>
+
 #include "ss.h"
 #include "sound.h"
 #include "scu.h"
@@ -50,6 +53,41 @@ static MDFN_jmp_buf jbuf;
 int16 IBuffer[1024][2];
 static uint32 IBufferCount;
 
+//
+// Optional host thread for the sound block(68K + SCSP).
+//
+// SOUND_Update() normally runs the sound block inline up to the event's timestamp.  With the thread enabled, it just
+// raises the thread's run-until target and returns, so the sound block reaches the same points while the SH-2s keep
+// going.  Everything on the emulation thread that touches sound state(SCSP register and sound RAM accesses, 68K
+// reset/halt, the CD-DA buffer, timestamp rebasing, save states, output flushing) calls SOUND_Sync() first, and so
+// sees the sound block exactly where it would be without the thread.
+//
+// The SCSP's main-CPU interrupt output can't be handled that way, so the thread is only handed work while the SCU
+// masks that interrupt and starts no DMA on it(see SCU_CanDeferInt()).  Changes to the output are then collected on
+// the thread and passed to the SCU by SOUND_Sync(), which runs before any SCU register access, where they'd first
+// have an effect.
+//
+// Not synchronized: SH-2 instruction fetches from sound RAM, which read it directly through the SH-2 fast map.
+//
+// Either side waits for the other with SoundThread_WaitFor(), which spins briefly and then sleeps on SoundThreadCond
+// until the other side's SoundThread_Wake().
+//
+enum { SOUNDTHREAD_SPIN_COUNT = 4096 };
+
+static sthread_t* SoundThread = NULL;
+static slock_t* SoundThreadLock = NULL;
+static scond_t* SoundThreadCond = NULL;
+static std::atomic<uint32> SoundThreadSleepers;
+static std::atomic<int32> SoundThreadUntil;
+static std::atomic<uint32> SoundThreadPostSeq;
+static std::atomic<uint32> SoundThreadDoneSeq;
+static std::atomic_bool SoundThreadExit;
+static bool SoundThreadMainInt;		// Main-CPU interrupt level last output by the SCSP on the thread.
+static bool SoundThreadMainIntRose;	// That level has gone from 0 to 1 on the thread.
+static bool SoundThreadEnabled;
+static bool SoundThreadBusy;	// Work has been handed to the thread since the last SOUND_Sync().
+static bool MainIntLevel;	// Level last passed to SCU_SetInt().
+
 static INLINE void SCSP_SoundIntChanged(SS_SCSP* s, unsigned level)
 {
  SoundCPU.SetIPL(level);
@@ -57,6 +95,15 @@ static INLINE void SCSP_SoundIntChanged(SS_SCSP* s, unsigned level)
 
 static INLINE void SCSP_MainIntChanged(SS_SCSP* s, bool state)
 {
+ // Only the sound thread can be running SCSP code while SoundThreadBusy is set.
+ if(SoundThreadBusy)
+ {
+  SoundThreadMainIntRose |= state & !SoundThreadMainInt;
+  SoundThreadMainInt = state;
+  return;
+ }
+
+ MainIntLevel = state;
  SCU_SetInt(SCU_INT_SCSP, state);
 }
 
@@ -80,9 +127,15 @@ static MDFN_FASTCALL void SoundCPU_BusRESET(bool state);
 
 void SOUND_Init(void)
 {
+ SS_RegisterMemoryRegion("Sound", &SCSP, sizeof(SCSP));
+
  memset(IBuffer, 0, sizeof(IBuffer));
  IBufferCount = 0;
 
+ SoundThreadEnabled = false;
+ SoundThreadBusy = false;
+ MainIntLevel = false;
+
  run_until_time = 0;
  next_scsp_time = 0;
  lastts = 0;
@@ -100,29 +153,50 @@ void SOUND_Init(void)
  SoundCPU.BusIntAck = SoundCPU_BusIntAck;
  SoundCPU.BusRESET = SoundCPU_BusRESET;
 
+ //
+ // Opcode fetches and (between SCSP sample updates) data reads from sound RAM bypass the bus callbacks; same
+ // 4 + 2 cycle timing as SoundCPU_BusRead() and SoundCPU_BusReadInstr().
+ //
+ SoundCPU.SetFastMap(0x000000, 0x07FFFF, SCSP.GetRAMPtr(), 0x80000);
+ SoundCPU.FastMapCycles = 6;
+ SoundCPU.FastMapReadLimit = next_scsp_time;
+
  SS_SetPhysMemMap(0x05A00000, 0x05A7FFFF, SCSP.GetRAMPtr(), 0x80000, true);
  // TODO: MEM4B: SS_SetPhysMemMap(0x05A00000, 0x05AFFFFF, SCSP.GetRAMPtr(), 0x40000, true);
 }
 
 uint8 SOUND_PeekRAM(uint32 A)
 {
+ SOUND_Sync();
+
  return ne16_rbo_be<uint8>(SCSP.GetRAMPtr(), A & 0x7FFFF);
 }
 
 void SOUND_PokeRAM(uint32 A, uint8 V)
 {
+ SOUND_Sync();
+
  ne16_wbo_be<uint8>(SCSP.GetRAMPtr(), A & 0x7FFFF, V);
 }
 
+void SOUND_WriteRAMBlock16(uint32 A, const uint16* src, uint32 count)
+{
+ SOUND_Sync();
+
+ memcpy(SCSP.GetRAMPtr() + ((A & 0x7FFFE) >> 1), src, count * sizeof(uint16));
+}
+
 static INLINE void ResetTS_68K(void)
 {
  next_scsp_time -= SoundCPU.timestamp;
  run_until_time -= (int64)SoundCPU.timestamp << 32;
  SoundCPU.timestamp = 0;
+ SoundCPU.FastMapReadLimit = next_scsp_time;
 }
 
 void SOUND_AdjustTS(const int32 delta)
 {
+ SOUND_Sync();
  ResetTS_68K();
  //
  //
@@ -131,21 +205,25 @@ void SOUND_AdjustTS(const int32 delta)
 
 void SOUND_Reset(bool powering_up)
 {
+ SOUND_Sync();
  SCSP.Reset(powering_up);
  SoundCPU.Reset(powering_up);
 }
 
 void SOUND_Reset68K(void)
 {
+ SOUND_Sync();
  SoundCPU.Reset(false);
 }
 
 void SOUND_Kill(void)
 {
+ SOUND_SetThreaded(false);
 }
 
 void SOUND_Set68KActive(bool active)
 {
+ SOUND_Sync();
  SoundCPU.SetExtHalted(!active);
 }
 
@@ -153,6 +231,7 @@ uint16 SOUND_Read16(uint32 A)
 {
  uint16 ret;
 
+ SOUND_Sync();
  SCSP.RW<uint16, false>(A, ret);
 
  return ret;
@@ -160,11 +239,13 @@ uint16 SOUND_Read16(uint32 A)
 
 void SOUND_Write8(uint32 A, uint8 V)
 {
+ SOUND_Sync();
  SCSP.RW<uint8, true>(A, V);
 }
 
 void SOUND_Write16(uint32 A, uint16 V)
 {
+ SOUND_Sync();
  SCSP.RW<uint16, true>(A, V);
 }
 
@@ -193,6 +274,7 @@ static NO_INLINE void RunSCSP(void)
 
  IBufferCount = (IBufferCount + 1) & 1023;
  next_scsp_time += 256;
+ SoundCPU.FastMapReadLimit = next_scsp_time;
 }
 
 // Ratio between SH-2 clock and 68K clock (sound clock / 2)
@@ -201,31 +283,178 @@ void SOUND_SetClockRatio(uint32 ratio)
  clock_ratio = ratio;
 }
 
-sscpu_timestamp_t SOUND_Update(sscpu_timestamp_t timestamp)
+static void RunUntil(const int32 until)
 {
- run_until_time += ((uint64)(timestamp - lastts) * clock_ratio);
- lastts = timestamp;
- //
- //
  MDFN_setjmp(jbuf);
 
- if(MDFN_LIKELY(SoundCPU.timestamp < (run_until_time >> 32)))
+ if(MDFN_LIKELY(SoundCPU.timestamp < until))
  {
   do
   {
-   int32 next_time = std::min<int32>(next_scsp_time, run_until_time >> 32);
+   int32 next_time = std::min<int32>(next_scsp_time, until);
 
    SoundCPU.Run(next_time);
 
    if(SoundCPU.timestamp >= next_scsp_time)
     RunSCSP();
-  } while(MDFN_LIKELY(SoundCPU.timestamp < (run_until_time >> 32)));
+  } while(MDFN_LIKELY(SoundCPU.timestamp < until));
  }
  else
  {
-  while(next_scsp_time < (run_until_time >> 32))
+  while(next_scsp_time < until)
    RunSCSP();
  }
+}
+
+static INLINE void SoundThread_Pause(void)
+{
+ #ifdef _MSC_VER
+ __nop();
+ #else
+ asm volatile("nop\n\t");
+ #endif
+}
+
+// Returns once "seq" equals "val"(or, with "equal" false, once it doesn't), or SoundThreadExit is set.
+static void SoundThread_WaitFor(const std::atomic<uint32>& seq, const uint32 val, const bool equal)
+{
+ for(unsigned i = 0; i < SOUNDTHREAD_SPIN_COUNT; i++)
+ {
+  if((seq.load(std::memory_order_acquire) == val) == equal || SoundThreadExit.load(std::memory_order_relaxed))
+   return;
+
+  SoundThread_Pause();
+ }
+
+ // Registering as a sleeper before re-checking "seq" pairs with SoundThread_Wake() storing "seq" before checking
+ // for sleepers, so one of the two always sees the other.
+ slock_lock(SoundThreadLock);
+ SoundThreadSleepers.fetch_add(1, std::memory_order_seq_cst);
+
+ while((seq.load(std::memory_order_seq_cst) == val) != equal && !SoundThreadExit.load(std::memory_order_seq_cst))
+  scond_wait(SoundThreadCond, SoundThreadLock);
+
+ SoundThreadSleepers.fetch_sub(1, std::memory_order_relaxed);
+ slock_unlock(SoundThreadLock);
+}
+
+// Call after storing to what the other side waits on(with std::memory_order_seq_cst).
+static INLINE void SoundThread_Wake(void)
+{
+ if(SoundThreadSleepers.load(std::memory_order_seq_cst))
+ {
+  slock_lock(SoundThreadLock);
+  scond_broadcast(SoundThreadCond);
+  slock_unlock(SoundThreadLock);
+ }
+}
+
+static void SoundThreadEntry(void* data)
+{
+ uint32 done = SoundThreadDoneSeq.load(std::memory_order_relaxed);
+
+ for(;;)
+ {
+  SoundThread_WaitFor(SoundThreadPostSeq, done, false);
+
+  if(SoundThreadExit.load(std::memory_order_relaxed))
+   return;
+
+  const uint32 seq = SoundThreadPostSeq.load(std::memory_order_acquire);
+
+  RunUntil(SoundThreadUntil.load(std::memory_order_relaxed));
+
+  done = seq;
+  SoundThreadDoneSeq.store(done, std::memory_order_seq_cst);
+  SoundThread_Wake();
+ }
+}
+
+void SOUND_Sync(void)
+{
+ if(MDFN_LIKELY(!SoundThreadBusy))
+  return;
+
+ SoundThread_WaitFor(SoundThreadDoneSeq, SoundThreadPostSeq.load(std::memory_order_relaxed), true);
+
+ SoundThreadBusy = false;
+
+ // Replay a rising edge even if the level is back where it was, since the SCU latches it as pending.
+ if(SoundThreadMainIntRose)
+ {
+  if(MainIntLevel)
+   SCU_SetInt(SCU_INT_SCSP, false);
+
+  MainIntLevel = true;
+  SCU_SetInt(SCU_INT_SCSP, true);
+ }
+
+ if(SoundThreadMainInt != MainIntLevel)
+ {
+  MainIntLevel = SoundThreadMainInt;
+  SCU_SetInt(SCU_INT_SCSP, MainIntLevel);
+ }
+}
+
+void SOUND_SetThreaded(bool threaded)
+{
+ SOUND_Sync();
+
+ if(threaded && !SoundThread)
+ {
+  if(!SoundThreadLock)
+  {
+   SoundThreadLock = slock_new();
+   SoundThreadCond = scond_new();
+  }
+
+  SoundThreadExit.store(false, std::memory_order_relaxed);
+  SoundThreadSleepers.store(0, std::memory_order_relaxed);
+  SoundThreadPostSeq.store(0, std::memory_order_relaxed);
+  SoundThreadDoneSeq.store(0, std::memory_order_relaxed);
+  SoundThread = sthread_create(SoundThreadEntry, NULL);
+ }
+ else if(!threaded && SoundThread)
+ {
+  SoundThreadExit.store(true, std::memory_order_seq_cst);
+  SoundThread_Wake();
+  sthread_join(SoundThread);
+  SoundThread = NULL;
+ }
+
+ if(!SoundThread && SoundThreadLock)
+ {
+  scond_free(SoundThreadCond);
+  SoundThreadCond = NULL;
+
+  slock_free(SoundThreadLock);
+  SoundThreadLock = NULL;
+ }
+
+ SoundThreadEnabled = (SoundThread != NULL);
+}
+
+sscpu_timestamp_t SOUND_Update(sscpu_timestamp_t timestamp)
+{
+ run_until_time += ((uint64)(timestamp - lastts) * clock_ratio);
+ lastts = timestamp;
+ //
+ //
+ if(SoundThreadEnabled && (SoundThreadBusy || SCU_CanDeferInt(SCU_INT_SCSP)))
+ {
+  if(!SoundThreadBusy)
+  {
+   SoundThreadMainInt = MainIntLevel;
+   SoundThreadMainIntRose = false;
+   SoundThreadBusy = true;
+  }
+
+  SoundThreadUntil.store(run_until_time >> 32, std::memory_order_relaxed);
+  SoundThreadPostSeq.store(SoundThreadPostSeq.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+  SoundThread_Wake();
+ }
+ else
+  RunUntil(run_until_time >> 32);
 
  return timestamp + 128;	// FIXME
 }
@@ -236,6 +465,8 @@ void SOUND_StartFrame(double rate, uint32 quality)
 
 int32 SOUND_FlushOutput(void)
 {
+ SOUND_Sync();
+
  int32 ret = IBufferCount;
 
  IBufferCount = 0;
@@ -245,6 +476,8 @@ int32 SOUND_FlushOutput(void)
 
 void SOUND_StateAction(StateMem* sm, const unsigned load, const bool data_only)
 {
+ SOUND_Sync();
+
  SFORMAT StateRegs[] =
  {
   SFVAR(next_scsp_time),
@@ -261,6 +494,7 @@ void SOUND_StateAction(StateMem* sm, const unsigned load, const bool data_only)
 
  next_scsp_time += SoundCPU.timestamp;
  run_until_time += (int64)SoundCPU.timestamp << 32;
+ SoundCPU.FastMapReadLimit = next_scsp_time;
  //
 
  SoundCPU.StateAction(sm, load, data_only, "M68K");
@@ -394,20 +628,24 @@ static MDFN_FASTCALL void SoundCPU_BusRESET(bool state)
 
 uint32 SOUND_GetSCSPRegister(const unsigned id, char* const special, const uint32 special_len)
 {
+ SOUND_Sync();
  return SCSP.GetRegister(id, special, special_len);
 }
 
 void SOUND_SetSCSPRegister(const unsigned id, const uint32 value)
 {
+ SOUND_Sync();
  SCSP.SetRegister(id, value);
 }
 
 uint32 SOUND_GetM68KRegister(const unsigned id, char* const special, const uint32 special_len)
 {
+ SOUND_Sync();
  return SoundCPU.GetRegister(id, special, special_len);
 }
 
 void SOUND_SetM68KRegister(const unsigned id, const uint32 value)
 {
+ SOUND_Sync();
  SoundCPU.SetRegister(id, value);
 }
@@ -35,6 +35,8 @@ void SOUND_Reset68K(void);
 
 void SOUND_SetClockRatio(uint32 ratio); // Ratio between SH-2 clock and 68K clock (sound clock / 2)
 sscpu_timestamp_t SOUND_Update(sscpu_timestamp_t timestamp);
+void SOUND_Sync(void);	// Wait for the sound thread, if any, to catch up to the last SOUND_Update().
+void SOUND_SetThreaded(bool threaded);
 void SOUND_AdjustTS(const int32 delta);
 int32 SOUND_FlushOutput(void);
 void SOUND_StateAction(StateMem *sm, const unsigned load, const bool data_only);
@@ -45,6 +47,7 @@ void SOUND_Write16(uint32 A, uint16 V);
 
 uint8 SOUND_PeekRAM(uint32 A);
 void SOUND_PokeRAM(uint32 A, uint8 V);
+void SOUND_WriteRAMBlock16(uint32 A, const uint16* src, uint32 count);
 
 uint32 SOUND_GetSCSPRegister(const unsigned id, char* const special, const uint32 special_len) MDFN_COLD;
 void SOUND_SetSCSPRegister(const unsigned id, const uint32 value) MDFN_COLD;
@@ -27,6 +27,7 @@
 #include "../general.h"
 #include "../cdrom/cdromif.h"
 #include "../FileStream.h"
+#include "../MemoryStream.h"
 #include "../hash/sha256.h"
 #include "../hash/md5.h"
 #include "ss.h"
@@ -35,7 +36,16 @@
 #include "../../disc.h"
 
 #include <bitset>
+#include <atomic>
+#include <deque>
+#include <streams/file_stream.h>
 #include <retro_miscellaneous.h>
+#include <rthreads/rthreads.h>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 extern MDFNGI EmulatedSS;
 
@@ -81,6 +91,7 @@ static void LoadRTC(void);
 
 static MDFN_COLD void BackupBackupRAM(void);
 static MDFN_COLD void BackupCartNV(void);
+static MDFN_COLD void NVWriter_Kill(void);
 
 #include "sh7095.h"
 
@@ -91,8 +102,27 @@ static void CheckEventsByMemTS(void);
 
 SH7095 CPU[2]{ {"SH2-M", SS_EVENT_SH2_M_DMA, SCU_MSH2VectorFetch}, {"SH2-S", SS_EVENT_SH2_S_DMA, SCU_SSH2VectorFetch}};
 
+#define SH7095_EXT_MAP_GRAN_BITS 16
+
+//
+// Work RAM and the SH-2 fast map are touched by nearly every SH-2 memory access, so keep them together and
+// huge-page aligned, to be backed by transparent huge pages where available(see InitHotMem()).
+//
+#if defined(__linux__) && (defined(__GNUC__) || defined(__clang__))
+ #define SS_HOTMEM_HUGEPAGES 1
+ #define SS_HOTMEM_ALIGN alignas(0x200000)
+#else
+ #define SS_HOTMEM_ALIGN
+#endif
+
+static struct SS_HOTMEM_ALIGN
+{
+ uint8 WorkRAM[2*WORKRAM_BANK_SIZE_BYTES];
+ uintptr_t FastMap[1U << (32 - SH7095_EXT_MAP_GRAN_BITS)];
+} HotMem;
+
 static uint16 BIOSROM[524288 / sizeof(uint16)];
-uint8 WorkRAM[2*WORKRAM_BANK_SIZE_BYTES]; // unified 2MB work ram for linear access.
+uint8 (&WorkRAM)[2*WORKRAM_BANK_SIZE_BYTES] = HotMem.WorkRAM; // unified 2MB work ram for linear access.
 // Effectively 32-bit in reality, but 16-bit here because of CPU interpreter design(regarding fastmap).
 static uint16* WorkRAML = (uint16*)(WorkRAM + (WORKRAM_BANK_SIZE_BYTES*0));
 static uint16* WorkRAMH = (uint16*)(WorkRAM + (WORKRAM_BANK_SIZE_BYTES*1));
@@ -101,8 +131,53 @@ static bool BackupRAM_Dirty;
 static int64 BackupRAM_SaveDelay;
 static int64 CartNV_SaveDelay;
 
-#define SH7095_EXT_MAP_GRAN_BITS 16
-static uintptr_t SH7095_FastMap[1U << (32 - SH7095_EXT_MAP_GRAN_BITS)];
+//
+// Backup RAM, cart NV and RTC files are written by a separate thread, from snapshots taken on the emulation thread,
+// via a temporary file that's renamed over the old one; a failed write leaves the previous file intact.
+//
+enum
+{
+ NVFILE_BACKUPRAM = 0,
+ NVFILE_CARTNV,
+ NVFILE_RTC,
+ NVFILE__COUNT
+};
+
+struct NVWriteJob
+{
+ unsigned which;
+ std::string path;
+ std::vector<uint8> data;
+};
+
+static sthread_t* NVWriter_Thread = NULL;
+static slock_t* NVWriter_Lock = NULL;
+static scond_t* NVWriter_Cond = NULL;
+static std::deque<NVWriteJob> NVWriter_Queue;	// Protected by NVWriter_Lock
+static bool NVWriter_Exit;			// Protected by NVWriter_Lock
+static std::atomic<bool> NVWriter_Failed[NVFILE__COUNT];
+
+static uintptr_t (&SH7095_FastMap)[1U << (32 - SH7095_EXT_MAP_GRAN_BITS)] = HotMem.FastMap;
+
+//
+// Slow-path external bus decode for CS0, CS1 and CS2, pre-resolved per SH7095_EXT_MAP_GRAN_BITS-sized page by
+// InitBusRegionMap(); every region boundary in the address map below falls on a page boundary.
+//
+enum
+{
+ BUSREGION_OPEN = 0,
+
+ BUSREGION_BIOS,
+ BUSREGION_SMPC,
+ BUSREGION_BACKUP_RAM,
+ BUSREGION_LOW_RAM,
+ BUSREGION_FRT,
+
+ BUSREGION_ABUS,
+ BUSREGION_BBUS,
+ BUSREGION_SCU_REGS
+};
+static uint8 SH7095_BusRegion[0x06000000 >> SH7095_EXT_MAP_GRAN_BITS];
 
 int32 SH7095_mem_timestamp;
 static uint32 SH7095_BusLock;
@@ -154,125 +229,131 @@ static uint16 fmap_dummy[(1U << SH7095_EXT_MAP_GRAN_BITS) / sizeof(uint16)];
 template<typename T, bool IsWrite>
 static INLINE void BusRW_DB_CS0(const uint32 A, uint32& DB, const bool BurstHax, int32* SH2DMAHax)
 {
- //
- // Low(and kinda slow) work RAM 
- //
- if(A >= 0x00200000 && A <= 0x003FFFFF)
+ switch(SH7095_BusRegion[A >> SH7095_EXT_MAP_GRAN_BITS])
  {
-  if(!SH2DMAHax)
-   SH7095_mem_timestamp += 7;
-  else
-   *SH2DMAHax += 7;
-
   //
-  // VA0 and VA1 don't map DRAM in the upper 1MiB of the 2MiB region, and return 0xFFFF(~0) on reads.
-  // VA2 mirrors DRAM into the upper 1MiB for both reads and writes, which incidentally breaks "Myst" in the generator room due to
-  //	it trying to load a file that's too large to fit, wrapping around and corrupting essential data in the process.
-  // VA3+ behavior is untested.
+  // Low(and kinda slow) work RAM 
   //
-  // VA0/VA1 behavior is emulated here.
-  //
-  if(MDFN_UNLIKELY(A & 0x100000))
+  case BUSREGION_LOW_RAM:
   {
-   if(!IsWrite)
-    DB = DB | 0xFFFF;
-
-   return;
-  }
+   if(!SH2DMAHax)
+    SH7095_mem_timestamp += 7;
+   else
+    *SH2DMAHax += 7;
 
-  if(IsWrite)
-   ne16_wbo_be<T>(WorkRAML, A & 0xFFFFF, DB >> (((A & 1) ^ (2 - sizeof(T))) << 3));
-  else
-   DB = (DB & 0xFFFF0000) | ne16_rbo_be<uint16>(WorkRAML, A & 0xFFFFE);
+   //
+   // VA0 and VA1 don't map DRAM in the upper 1MiB of the 2MiB region, and return 0xFFFF(~0) on reads.
+   // VA2 mirrors DRAM into the upper 1MiB for both reads and writes, which incidentally breaks "Myst" in the generator room due to
+   //	it trying to load a file that's too large to fit, wrapping around and corrupting essential data in the process.
+   // VA3+ behavior is untested.
+   //
+   // VA0/VA1 behavior is emulated here.
+   //
+   if(MDFN_UNLIKELY(A & 0x100000))
+   {
+    if(!IsWrite)
+     DB = DB | 0xFFFF;
 
-  return;
- }
+    return;
+   }
 
- //
- // BIOS ROM
- //
- if(A >= 0x00000000 && A <= 0x000FFFFF)
- {
-  if(!SH2DMAHax)
-   SH7095_mem_timestamp += 8;
-  else
-   *SH2DMAHax += 8;
+   if(IsWrite)
+    ne16_wbo_be<T>(WorkRAML, A & 0xFFFFF, DB >> (((A & 1) ^ (2 - sizeof(T))) << 3));
+   else
+    DB = (DB & 0xFFFF0000) | ne16_rbo_be<uint16>(WorkRAML, A & 0xFFFFE);
 
-  if(!IsWrite) 
-   DB = (DB & 0xFFFF0000) | ne16_rbo_be<uint16>(BIOSROM, A & 0x7FFFE);
+   return;
+  }
 
-  return;
- }
+  //
+  // BIOS ROM
+  //
+  case BUSREGION_BIOS:
+  {
+   if(!SH2DMAHax)
+    SH7095_mem_timestamp += 8;
+   else
+    *SH2DMAHax += 8;
 
- //
- // SMPC
- //
- if(A >= 0x00100000 && A <= 0x0017FFFF)
- {
-  const uint32 SMPC_A = (A & 0x7F) >> 1;
+   if(!IsWrite) 
+    DB = (DB & 0xFFFF0000) | ne16_rbo_be<uint16>(BIOSROM, A & 0x7FFFE);
 
-  if(!SH2DMAHax)
-  {
-   // SH7095_mem_timestamp += 2;
-   CheckEventsByMemTS();
+   return;
   }
 
-  if(IsWrite)
+  //
+  // SMPC
+  //
+  case BUSREGION_SMPC:
   {
-   if(sizeof(T) == 2 || (A & 1))
-    SMPC_Write(SH7095_mem_timestamp, SMPC_A, DB);
-  }
-  else
-   DB = (DB & 0xFFFF0000) | 0xFF00 | SMPC_Read(SH7095_mem_timestamp, SMPC_A);
+   const uint32 SMPC_A = (A & 0x7F) >> 1;
 
-  return;
- }
-
- //
- // Backup RAM
- //
- if(A >= 0x00180000 && A <= 0x001FFFFF)
- {
-  if(!SH2DMAHax)
-   SH7095_mem_timestamp += 8;
-  else
-   *SH2DMAHax += 8;
+   if(!SH2DMAHax)
+   {
+    // SH7095_mem_timestamp += 2;
+    CheckEventsByMemTS();
+   }
 
-  if(IsWrite)
-  {
-   if(sizeof(T) != 1 || (A & 1))
+   if(IsWrite)
    {
-    BackupRAM[(A >> 1) & 0x7FFF] = DB;
-    BackupRAM_Dirty = true;
+    if(sizeof(T) == 2 || (A & 1))
+     SMPC_Write(SH7095_mem_timestamp, SMPC_A, DB);
    }
+   else
+    DB = (DB & 0xFFFF0000) | 0xFF00 | SMPC_Read(SH7095_mem_timestamp, SMPC_A);
+
+   return;
   }
-  else
-   DB = (DB & 0xFFFF0000) | 0xFF00 | BackupRAM[(A >> 1) & 0x7FFF];
 
-  return;
- }
+  //
+  // Backup RAM
+  //
+  case BUSREGION_BACKUP_RAM:
+  {
+   if(!SH2DMAHax)
+    SH7095_mem_timestamp += 8;
+   else
+    *SH2DMAHax += 8;
 
- //
- // FRT trigger region
- //
- if(A >= 0x01000000 && A <= 0x01FFFFFF)
- {
-  if(!SH2DMAHax)
-   SH7095_mem_timestamp += 8;
-  else
-   *SH2DMAHax += 8;
+   if(IsWrite)
+   {
+    if(sizeof(T) != 1 || (A & 1))
+    {
+     BackupRAM[(A >> 1) & 0x7FFF] = DB;
+     BackupRAM_Dirty = true;
+    }
+   }
+   else
+    DB = (DB & 0xFFFF0000) | 0xFF00 | BackupRAM[(A >> 1) & 0x7FFF];
 
-  if(IsWrite)
+   return;
+  }
+
+  //
+  // FRT trigger region
+  //
+  case BUSREGION_FRT:
   {
-   if(sizeof(T) != 1)
+   if(!SH2DMAHax)
+    SH7095_mem_timestamp += 8;
+   else
+    *SH2DMAHax += 8;
+
+   if(IsWrite)
    {
-    const unsigned c = ((A >> 23) & 1) ^ 1;
+    if(sizeof(T) != 1)
+    {
+     const unsigned c = ((A >> 23) & 1) ^ 1;
 
-    CPU[c].SetFTI(true);
-    CPU[c].SetFTI(false);
+     CPU[c].SetFTI(true);
+     CPU[c].SetFTI(false);
+    }
    }
+   return;
   }
-  return;
+
+  default:
+	break;
  }
 
  //
@@ -328,6 +409,9 @@ static MDFN_COLD void CheatMemWrite(uint32 A, uint8 V)
  {
   ne16_wbo_be<uint8>(SH7095_FastMap[A >> SH7095_EXT_MAP_GRAN_BITS], A, V);
 
+  if((A &~ 0x7FFFF) == 0x05C00000)
+   VDP1::VRAMWritten(A);
+
   for(unsigned c = 0; c < 2; c++)
   {
    if(CPU[c].CCR & SH7095::CCR_CE)
@@ -363,8 +447,42 @@ static void SetFastMemMap(uint32 Astart, uint32 Aend, uint16* ptr, uint32 length
  }
 }
 
+static MDFN_COLD void InitBusRegionMap(void)
+{
+ static const struct
+ {
+  uint32 Astart;
+  uint32 Aend;
+  uint8 region;
+ } regions[] =
+ {
+  { 0x00000000, 0x000FFFFF, BUSREGION_BIOS },
+  { 0x00100000, 0x0017FFFF, BUSREGION_SMPC },
+  { 0x00180000, 0x001FFFFF, BUSREGION_BACKUP_RAM },
+  { 0x00200000, 0x003FFFFF, BUSREGION_LOW_RAM },
+  { 0x01000000, 0x01FFFFFF, BUSREGION_FRT },
+
+  { 0x02000000, 0x058FFFFF, BUSREGION_ABUS },
+  { 0x05A00000, 0x05FBFFFF, BUSREGION_BBUS },
+  { 0x05FE0000, 0x05FEFFFF, BUSREGION_SCU_REGS },
+ };
+
+ memset(SH7095_BusRegion, BUSREGION_OPEN, sizeof(SH7095_BusRegion));
+
+ for(auto const& r : regions)
+ {
+  assert((r.Astart & ((1U << SH7095_EXT_MAP_GRAN_BITS) - 1)) == 0);
+  assert(((r.Aend + 1) & ((1U << SH7095_EXT_MAP_GRAN_BITS) - 1)) == 0);
+
+  for(uint32 A = r.Astart; A <= r.Aend; A += (1U << SH7095_EXT_MAP_GRAN_BITS))
+   SH7095_BusRegion[A >> SH7095_EXT_MAP_GRAN_BITS] = r.region;
+ }
+}
+
 static MDFN_COLD void InitFastMemMap(void)
 {
+ InitBusRegionMap();
+
  for(unsigned i = 0; i < sizeof(fmap_dummy) / sizeof(fmap_dummy[0]); i++)
  {
   fmap_dummy[i] = 0;
@@ -394,8 +512,81 @@ void SS_SetPhysMemMap(uint32 Astart, uint32 Aend, uint16* ptr, uint32 length, bo
   SetFastMemMap(Astart + Abase, Aend + Abase, ptr, length, is_writeable);
 }
 
+//
+// Quantum-based master/slave SH-2 interleaving, for when CPU cache emulation is not enabled.
+//
+// Instead of catching the slave up after every master instruction, RunLoop() lets the master run ahead for up to
+// SH2Quantum cycles(and never past the next event).  Accesses by either CPU to addresses the other CPU can
+// observe(SMPC, FRT input capture, SCU registers, cache-through work RAM) or whose effects depend on when they
+// happen(CD block, SCSP, VDP1 and VDP2 registers) drop back to lockstep for a while, as does SH-2 DMA activity;
+// the master also catches the slave up right before making such an access itself.  Cartridge, sound RAM, VRAM,
+// framebuffer and CRAM accesses aren't ordered between the CPUs.
+//
+static int32 SH2Quantum;	// 0 = lockstep.
+static sscpu_timestamp_t SH2Quantum_SlaveSyncTS;
+static sscpu_timestamp_t SH2Quantum_LockstepUntil;
+
+static INLINE bool SH2Quantum_IsSharedAddr(const uint32 A)
+{
+ const uint32 PA = A & 0x07FFFFFF;
+
+ if(PA >= 0x06000000)
+  return (A >> 29) == 1;
+
+ switch(SH7095_BusRegion[PA >> SH7095_EXT_MAP_GRAN_BITS])
+ {
+  case BUSREGION_LOW_RAM:
+	return (A >> 29) == 1;
+
+  case BUSREGION_SMPC:
+  case BUSREGION_FRT:
+  case BUSREGION_SCU_REGS:
+	return true;
+
+  case BUSREGION_ABUS:
+	return PA >= 0x05800000;	// CD block
+
+  case BUSREGION_BBUS:
+	return (PA >= 0x05B00000 && PA <= 0x05BFFFFF) ||	// SCSP registers
+	       (PA >= 0x05D00000 && PA <= 0x05D7FFFF) ||	// VDP1 registers
+	       (PA >= 0x05F80000);				// VDP2 registers
+ }
+
+ return false;
+}
+
+template<unsigned which>
+static NO_INLINE void SH2Quantum_SharedAccess(void);
+
 #include "sh7095.inc"
 
+template<unsigned which>
+static NO_INLINE void SH2Quantum_SharedAccess(void)
+{
+ SH2Quantum_LockstepUntil = CPU[0].timestamp + SH2Quantum * 4;
+ SH2Quantum_SlaveSyncTS = 0;
+
+ if(!which && !SH7095_BusLock)
+ {
+  while(CPU[0].timestamp > CPU[1].timestamp)
+   CPU[1].Step<1, false>();
+ }
+}
+
+static INLINE sscpu_timestamp_t SH2Quantum_NextSync(void)
+{
+ if(!SH2Quantum || CPU[0].timestamp < SH2Quantum_LockstepUntil)
+  return 0;
+
+ for(unsigned c = 0; c < 2; c++)
+ {
+  if(CPU[c].DMA_RunCond(0) || CPU[c].DMA_RunCond(1))
+   return 0;
+ }
+
+ return CPU[0].timestamp + SH2Quantum;
+}
+
 //
 // Running is:
 //   0 at end of (emulation) frame
@@ -592,6 +783,238 @@ void SS_RequestMLExit(void)
  next_event_ts = 0;
 }
 
+//
+// Busy-wait loop skipping
+//
+// Each time the master SH-2 branches back to the head of a short loop, a snapshot is taken of both CPUs' register,
+// pipeline, cache LRU and timing state(timestamps relative to the master's).  If it's identical to the snapshot
+// taken on the previous iteration, and the loop(and the loop the slave is in, if it's running) can't affect
+// anything outside of the CPUs, then the CPUs will keep repeating that iteration until something external happens,
+// which can only be from an event or an on-chip timer update.  The iterations before that point are then skipped
+// all at once by advancing the timestamps by a whole multiple of the iteration length, with the same result as
+// running them.
+//
+enum { IDLELOOP_MAX_LEN = 64 };
+enum { IDLESNAP_CPU_WORDS = 16 + 12 + 1 + 3 + 16 + 4 + 64 / 4 };
+
+struct IdleLoopTracker
+{
+ uint32 head;	// Address of the first instruction in the loop.
+ uint32 last;	// Address of the last instruction executed before "head"(the delay slot, for a delayed branch).
+ uint32 gen;	// Incremented whenever "head" or "last" changes.
+};
+
+static IdleLoopTracker IdleLoop[2];
+static uint32 IdleSnap[IDLESNAP_CPU_WORDS * 2 + 5];
+static sscpu_timestamp_t IdleSnapTS;
+static bool IdleSnapValid;
+
+static struct
+{
+ int64 skipped[2];
+ int64 total;
+ unsigned frames;
+} IdleStats;
+
+static void IdleLoop_Reset(void)
+{
+ memset(IdleLoop, 0, sizeof(IdleLoop));
+ IdleSnapValid = false;
+}
+
+// Called after CPU[which] has branched backward from prev_pc; returns true if it's the same loop as last time.
+//
+// The branch instruction was at prev_pc - 4.  After BT or BF, the target is at PC - 4; after BRA, BT/S or BF/S,
+// the delay slot instruction at prev_pc - 2 hasn't run yet, and the target is at PC - 2.
+static INLINE bool IdleLoop_NoteBranch(const unsigned which, const uint32 prev_pc)
+{
+ IdleLoopTracker* const t = &IdleLoop[which];
+ const bool delayed = CPU[which].IdleLoop_InDelaySlot();
+ const uint32 head = CPU[which].PC - (delayed ? 2 : 4);
+ const uint32 last = prev_pc - (delayed ? 2 : 4);
+
+ if(head == t->head && last == t->last)
+  return true;
+
+ t->head = head;
+ t->last = last;
+ t->gen++;
+
+ return false;
+}
+
+static uint32* IdleLoop_SnapCPU(uint32* p, const SH7095& cpu, const sscpu_timestamp_t base)
+{
+ const sscpu_timestamp_t ts = cpu.timestamp;
+
+ for(unsigned i = 0; i < 16; i++)
+  *p++ = cpu.R[i];
+
+ *p++ = cpu.PC;
+ *p++ = cpu.SR;
+ *p++ = cpu.GBR;
+ *p++ = cpu.VBR;
+ *p++ = cpu.MACH;
+ *p++ = cpu.MACL;
+ *p++ = cpu.PR;
+ *p++ = cpu.Pipe_ID;
+ *p++ = cpu.Pipe_IF;
+ *p++ = cpu.IBuffer;
+ *p++ = cpu.EPending;
+ *p++ = cpu.UCRead_IF_Kludge;
+
+ *p++ = ts - base;
+
+ // Pipeline and bus timing variables only matter relative to the CPU's own timestamp, and only while they're
+ // still ahead of it(or just behind, for the bus ones).
+ *p++ = std::max<sscpu_timestamp_t>(-1, cpu.MA_until - ts);
+ *p++ = std::max<sscpu_timestamp_t>(-1, cpu.MM_until - ts);
+ *p++ = std::max<sscpu_timestamp_t>(-1, cpu.write_finish_timestamp - ts);
+ for(unsigned i = 0; i < 16; i++)
+  *p++ = std::max<sscpu_timestamp_t>(-1, cpu.WB_until[i] - ts);
+
+ *p++ = std::max<sscpu_timestamp_t>(-1, cpu.BSC.sdram_finish_time - ts);
+ *p++ = std::max<sscpu_timestamp_t>(-2, cpu.BSC.last_mem_time - ts);
+ *p++ = cpu.BSC.last_mem_addr;
+ *p++ = cpu.BSC.last_mem_type;
+
+ memcpy(p, cpu.Cache_LRU, sizeof(cpu.Cache_LRU));
+ p += sizeof(cpu.Cache_LRU) / sizeof(uint32);
+
+ return p;
+}
+
+static void IdleLoop_AdvanceCPU(SH7095* cpu, const sscpu_timestamp_t delta)
+{
+ cpu->timestamp += delta;
+ cpu->MA_until += delta;
+ cpu->MM_until += delta;
+ cpu->write_finish_timestamp += delta;
+
+ for(unsigned i = 0; i < 16; i++)
+  cpu->WB_until[i] += delta;
+
+ cpu->BSC.sdram_finish_time += delta;
+ cpu->BSC.last_mem_time += delta;
+}
+
+// Called after the master CPU has branched backward from prev_pc, and the slave CPU has caught up; returns the
+// new effective timestamp.
+template<bool EmulateICache>
+static NO_INLINE sscpu_timestamp_t IdleLoop_Check(const uint32 prev_pc, sscpu_timestamp_t eff_ts)
+{
+ const bool slave_on = (CPU[1].timestamp != SS_EVENT_DISABLED_TS);
+ uint32 snap[sizeof(IdleSnap) / sizeof(IdleSnap[0])];
+ uint32* p = snap;
+ bool match;
+ sscpu_timestamp_t period;
+
+ // The slave's progress can't be observed with RunSlaveUntil(), and it has to have been caught up if it's
+ // being interleaved by quantum.
+ if(!IdleLoop_NoteBranch(0, prev_pc) || (slave_on && (EmulateICache || CPU[1].timestamp < CPU[0].timestamp)))
+ {
+  IdleSnapValid = false;
+  return eff_ts;
+ }
+
+ p = IdleLoop_SnapCPU(p, CPU[0], CPU[0].timestamp);
+ if(slave_on)
+  p = IdleLoop_SnapCPU(p, CPU[1], CPU[0].timestamp);
+ else
+ {
+  memset(p, 0, IDLESNAP_CPU_WORDS * sizeof(uint32));
+  p += IDLESNAP_CPU_WORDS;
+ }
+ *p++ = SH7095_mem_timestamp - CPU[0].timestamp;
+ *p++ = SH7095_DB;
+ *p++ = slave_on ? IdleLoop[1].gen : 0;
+ *p++ = std::max<sscpu_timestamp_t>(0, SH2Quantum_SlaveSyncTS - CPU[0].timestamp);
+ *p++ = std::max<sscpu_timestamp_t>(0, SH2Quantum_LockstepUntil - CPU[0].timestamp);
+
+ match = IdleSnapValid && !memcmp(snap, IdleSnap, sizeof(IdleSnap));
+ period = CPU[0].timestamp - IdleSnapTS;
+
+ memcpy(IdleSnap, snap, sizeof(IdleSnap));
+ IdleSnapTS = CPU[0].timestamp;
+ IdleSnapValid = true;
+
+ if(!match || period <= 0)
+  return eff_ts;
+
+ if(CPU[0].DMA_PenaltyKludgeAmount || !CPU[0].IdleLoop_BodyIsPure(IdleLoop[0].head, IdleLoop[0].last))
+  return eff_ts;
+
+ if(slave_on)
+ {
+  // In a delay slot, only the one belonging to the loop's own branch(which ends the loop) is known to be inside it.
+  if(CPU[1].IdleLoop_InDelaySlot())
+  {
+   if(CPU[1].PC - 2 != IdleLoop[1].head)
+    return eff_ts;
+  }
+  else
+  {
+   const uint32 slave_pc = CPU[1].PC - 4;
+
+   if(slave_pc < IdleLoop[1].head || slave_pc > IdleLoop[1].last)
+    return eff_ts;
+  }
+
+  if(CPU[1].DMA_PenaltyKludgeAmount || !CPU[1].IdleLoop_BodyIsPure(IdleLoop[1].head, IdleLoop[1].last))
+   return eff_ts;
+ }
+
+ //
+ // Every iteration skipped must end before the next event, and start before the next FRT/WDT update.
+ //
+ sscpu_timestamp_t limit = next_event_ts - eff_ts;
+
+ limit = std::min<sscpu_timestamp_t>(limit, CPU[0].FRT_WDT_NextTS - CPU[0].timestamp);
+ if(slave_on)
+  limit = std::min<sscpu_timestamp_t>(limit, CPU[1].FRT_WDT_NextTS - CPU[1].timestamp);
+
+ if(limit <= period)
+  return eff_ts;
+
+ const sscpu_timestamp_t skip = (limit - 1) / period * period;
+
+ IdleLoop_AdvanceCPU(&CPU[0], skip);
+ IdleStats.skipped[0] += skip;
+
+ if(slave_on)
+ {
+  IdleLoop_AdvanceCPU(&CPU[1], skip);
+  IdleStats.skipped[1] += skip;
+ }
+
+ SH7095_mem_timestamp += skip;
+ IdleSnapTS += skip;
+
+ if(SH2Quantum_SlaveSyncTS > CPU[0].timestamp - skip)
+  SH2Quantum_SlaveSyncTS += skip;
+
+ if(SH2Quantum_LockstepUntil > CPU[0].timestamp - skip)
+  SH2Quantum_LockstepUntil += skip;
+
+ return eff_ts + skip;
+}
+
+static void IdleLoop_EndFrame(const sscpu_timestamp_t end_ts)
+{
+ // Snapshot timestamp is about to be rebased.
+ IdleSnapValid = false;
+
+ IdleStats.total += end_ts;
+
+ if(++IdleStats.frames == 300)
+ {
+  log_cb(RETRO_LOG_DEBUG, "[Mednafen]: Idle loop skip: %.1f%% master, %.1f%% slave SH-2 cycles over %u frames.\n",
+	100.0 * IdleStats.skipped[0] / IdleStats.total, 100.0 * IdleStats.skipped[1] / IdleStats.total, IdleStats.frames);
+
+  memset(&IdleStats, 0, sizeof(IdleStats));
+ }
+}
+
 #pragma GCC push_options
 #pragma GCC optimize("O2,no-unroll-loops,no-peel-loops,no-crossjumping")
 template<bool EmulateICache>
@@ -611,19 +1034,30 @@ static NO_INLINE MDFN_HOT int32 RunLoop(EmulateSpecStruct* espec)
   {
    do
    {
+    const uint32 master_pc = CPU[0].PC;
+
     CPU[0].Step<0, EmulateICache>();
-    CPU[0].DMA_BusTimingKludge();
+
+    if(MDFN_UNLIKELY(CPU[0].DMA_PenaltyKludgeAccum))
+     CPU[0].DMA_BusTimingKludge();
 
     if(EmulateICache)
     {
       CPU[1].RunSlaveUntil(CPU[0].timestamp);
     }
-    else
+    else if(CPU[0].timestamp >= SH2Quantum_SlaveSyncTS || std::max<sscpu_timestamp_t>(CPU[0].timestamp, SH7095_mem_timestamp) >= next_event_ts)
     {
      while(MDFN_LIKELY(CPU[0].timestamp > CPU[1].timestamp))
      {
+      const uint32 slave_pc = CPU[1].PC;
+
       CPU[1].Step<1, false>();
+
+      if(MDFN_UNLIKELY(CPU[1].PC < slave_pc) && setting_idle_skip)
+       IdleLoop_NoteBranch(1, slave_pc);
      }
+
+     SH2Quantum_SlaveSyncTS = SH2Quantum_NextSync();
     }
 
     eff_ts = CPU[0].timestamp;
@@ -631,6 +1065,9 @@ static NO_INLINE MDFN_HOT int32 RunLoop(EmulateSpecStruct* espec)
      eff_ts = SH7095_mem_timestamp;
     else
      SH7095_mem_timestamp = eff_ts;
+
+    if(MDFN_UNLIKELY(CPU[0].PC < master_pc) && setting_idle_skip)
+     eff_ts = IdleLoop_Check<EmulateICache>(master_pc, eff_ts);
    } while(MDFN_LIKELY(eff_ts < next_event_ts));
   } while(MDFN_LIKELY(EventHandler(eff_ts)));
  } while(MDFN_LIKELY(Running != 0));
@@ -645,6 +1082,8 @@ void SS_Reset(bool powering_up)
 {
  SH7095_BusLock = 0;
 
+ IdleLoop_Reset();
+
  if(powering_up)
  {
    memset(WorkRAM, 0x00, sizeof(WorkRAM));   // TODO: Check real hardware
@@ -719,12 +1158,20 @@ void Emulate(EmulateSpecStruct* espec_arg)
  //
  //
  //
+ SH2Quantum = (NeedEmuICache || (ss_horrible_hacks & HORRIBLEHACK_EXACTSH2INTERLEAVE)) ? 0 : setting_sh2_quantum;
+ SH2Quantum_SlaveSyncTS = 0;
+ SOUND_SetThreaded(setting_sound_thread);
+ CDB_SetFastCD(setting_cd_speed_shift);
+
  if (NeedEmuICache)
   end_ts = RunLoop<true>(espec);
  else
   end_ts = RunLoop<false>(espec);
  assert(end_ts >= 0);
 
+ if(setting_idle_skip)
+  IdleLoop_EndFrame(end_ts);
+
  ForceEventUpdates(end_ts);
  //
  SMPC_EndFrame(espec, end_ts);
@@ -744,6 +1191,7 @@ void Emulate(EmulateSpecStruct* espec_arg)
  UpdateInputLastBigTS -= (int64)end_ts * cur_clock_div * 1000 * 1000;
  //
  SH7095_mem_timestamp -= end_ts; // Update before CPU[n].AdjustTS()
+ SH2Quantum_LockstepUntil = std::max<sscpu_timestamp_t>(0, SH2Quantum_LockstepUntil - end_ts);
  //
  for(unsigned c = 0; c < 2; c++)
   CPU[c].AdjustTS(-end_ts);
@@ -769,17 +1217,10 @@ void Emulate(EmulateSpecStruct* espec_arg)
   BackupRAM_SaveDelay -= espec->MasterCycles;
 
   if(BackupRAM_SaveDelay <= 0)
-  {
-   try
-   {
-    SaveBackupRAM();
-   }
-   catch(std::exception& e)
-   {
-    BackupRAM_SaveDelay = (int64)60 * (EmulatedSS.MasterClock / MDFN_MASTERCLOCK_FIXED(1));  // 60 second retry delay.
-   }
-  }
+   SaveBackupRAM();
  }
+ else if(MDFN_UNLIKELY(NVWriter_Failed[NVFILE_BACKUPRAM].exchange(false, std::memory_order_relaxed)))
+  BackupRAM_SaveDelay = (int64)60 * (EmulatedSS.MasterClock / MDFN_MASTERCLOCK_FIXED(1));  // 60 second retry delay.
 
  if(CART_GetClearNVDirty())
   CartNV_SaveDelay = (int64)3 * (EmulatedSS.MasterClock / MDFN_MASTERCLOCK_FIXED(1));  // 3 second delay
@@ -788,25 +1229,117 @@ void Emulate(EmulateSpecStruct* espec_arg)
   CartNV_SaveDelay -= espec->MasterCycles;
 
   if(CartNV_SaveDelay <= 0)
-  {
-   try
-   {
-    SaveCartNV();
-   }
-   catch(std::exception& e)
-   {
-    CartNV_SaveDelay = (int64)60 * (EmulatedSS.MasterClock / MDFN_MASTERCLOCK_FIXED(1));  // 60 second retry delay.
-   }
-  }
+   SaveCartNV();
  }
+ else if(MDFN_UNLIKELY(NVWriter_Failed[NVFILE_CARTNV].exchange(false, std::memory_order_relaxed)))
+  CartNV_SaveDelay = (int64)60 * (EmulatedSS.MasterClock / MDFN_MASTERCLOCK_FIXED(1));  // 60 second retry delay.
 }
 
 //
 //
 //
 
+//
+//
+//
+struct MemoryRegion
+{
+ const char* subsystem;
+ const void* ptr;
+ size_t length;
+};
+
+static std::vector<MemoryRegion> MemoryRegions;
+
+void SS_RegisterMemoryRegion(const char* subsystem, const void* ptr, size_t length)
+{
+ MemoryRegions.push_back({ subsystem, ptr, length });
+}
+
+// Returns (size_t)-1 if unknown.
+static size_t GetResidentBytes(const void* ptr, size_t length)
+{
+#if defined(__linux__)
+ const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+ const uintptr_t start = (uintptr_t)ptr &~ (page_size - 1);
+ const uintptr_t end = ((uintptr_t)ptr + length + page_size - 1) &~ (page_size - 1);
+ std::vector<unsigned char> vec((end - start) / page_size);
+ size_t ret = 0;
+
+ if(mincore((void*)start, end - start, vec.data()) != 0)
+  return (size_t)-1;
+
+ for(auto const& v : vec)
+  ret += (v & 1) ? page_size : 0;
+
+ return std::min<size_t>(ret, length);
+#else
+ return (size_t)-1;
+#endif
+}
+
+static MDFN_COLD void InitHotMem(void)
+{
+#if defined(SS_HOTMEM_HUGEPAGES) && defined(MADV_HUGEPAGE)
+ if(setting_lean_memory)
+  return;
+
+ // The dynamic loader may not have honored the alignment, in which case only the aligned middle part can be huge.
+ if(madvise(&HotMem, sizeof(HotMem), MADV_HUGEPAGE) == 0)
+  log_cb(RETRO_LOG_INFO, "[Mednafen]: Requested huge pages for work RAM and fast map%s.\n", ((uintptr_t)&HotMem & 0x1FFFFF) ? " (misaligned)" : "");
+#endif
+}
+
+static MDFN_COLD void LogMemoryUsage(void)
+{
+ std::vector<MemoryRegion> totals;	// length is the total, ptr unused.
+ std::vector<size_t> resident;
+
+ for(auto const& mr : MemoryRegions)
+ {
+  const size_t rb = GetResidentBytes(mr.ptr, mr.length);
+  size_t i;
+
+  for(i = 0; i < totals.size() && strcmp(totals[i].subsystem, mr.subsystem); i++);
+
+  if(i == totals.size())
+  {
+   totals.push_back({ mr.subsystem, nullptr, 0 });
+   resident.push_back(0);
+  }
+
+  totals[i].length += mr.length;
+  resident[i] = (rb == (size_t)-1 || resident[i] == (size_t)-1) ? (size_t)-1 : (resident[i] + rb);
+ }
+
+ for(size_t i = 0; i < totals.size(); i++)
+ {
+  if(resident[i] == (size_t)-1)
+   log_cb(RETRO_LOG_INFO, "[Mednafen]: Memory: %-14s %6u KiB\n", totals[i].subsystem, (unsigned)(totals[i].length >> 10));
+  else
+   log_cb(RETRO_LOG_INFO, "[Mednafen]: Memory: %-14s %6u KiB resident of %6u KiB\n", totals[i].subsystem, (unsigned)(resident[i] >> 10), (unsigned)(totals[i].length >> 10));
+ }
+
+#if defined(__linux__)
+ {
+  FILE* fp = fopen("/proc/self/statm", "r");
+  unsigned long vm_pages, rss_pages;
+
+  if(fp)
+  {
+   if(fscanf(fp, "%lu %lu", &vm_pages, &rss_pages) == 2)
+    log_cb(RETRO_LOG_INFO, "[Mednafen]: Memory: process total %u KiB resident\n", (unsigned)((rss_pages * (unsigned long)sysconf(_SC_PAGESIZE)) >> 10));
+
+   fclose(fp);
+  }
+ }
+#endif
+}
+
 static MDFN_COLD void Cleanup(void)
 {
+ NVWriter_Kill();
+
  CART_Kill();
 
  VDP1::Kill();
@@ -906,6 +1439,13 @@ bool MDFN_COLD InitCommon(const unsigned cpucache_emumode, const unsigned horrib
    for(i = 0; i < 0x40; i++)
       BackupRAM[i] = BRAM_Init_Data[i & 0x0F];
 
+   InitHotMem();
+
+   MemoryRegions.clear();
+   SS_RegisterMemoryRegion("Work RAM", WorkRAM, sizeof(WorkRAM));
+   SS_RegisterMemoryRegion("BIOS", BIOSROM, sizeof(BIOSROM));
+   SS_RegisterMemoryRegion("SH-2", SH7095_FastMap, sizeof(SH7095_FastMap));
+
    // Call InitFastMemMap() before functions like SOUND_Init()
    InitFastMemMap();
    SS_SetPhysMemMap(0x00000000, 0x000FFFFF, BIOSROM, sizeof(BIOSROM));
@@ -970,7 +1510,7 @@ bool MDFN_COLD InitCommon(const unsigned cpucache_emumode, const unsigned horrib
    SCU_Init();
    SMPC_Init(smpc_area, MasterClock);
    VDP1::Init();
-   VDP2::Init(PAL,vdp2_affinity);
+   VDP2::Init(PAL,vdp2_affinity, setting_lean_memory);
    VDP2::SetGetVideoParams(&EmulatedSS, true, sls, sle, true, DoHBlend);
    CDB_Init();
    SOUND_Init();
@@ -1032,6 +1572,8 @@ bool MDFN_COLD InitCommon(const unsigned cpucache_emumode, const unsigned horrib
    //
    SS_Reset(true);
 
+   LogMemoryUsage();
+
    return true;
 }
 
@@ -1047,6 +1589,139 @@ MDFN_COLD void CloseGame(void)
  Cleanup();
 }
 
+static bool NVWriter_WriteFile(const std::string& path, const std::vector<uint8>& data)
+{
+ const std::string tmp_path = path + ".tmp";
+ RFILE* fp = filestream_open(tmp_path.c_str(), RETRO_VFS_FILE_ACCESS_WRITE, RETRO_VFS_FILE_ACCESS_HINT_NONE);
+ bool ok;
+
+ if(!fp)
+  return false;
+
+ ok = (filestream_write(fp, data.data(), data.size()) == (int64)data.size());
+ ok &= (filestream_flush(fp) == 0);
+ ok &= (filestream_close(fp) == 0);
+
+ if(ok && filestream_rename(tmp_path.c_str(), path.c_str()) != 0)
+ {
+  // Renaming over an existing file fails on some platforms.
+  filestream_delete(path.c_str());
+  ok = (filestream_rename(tmp_path.c_str(), path.c_str()) == 0);
+ }
+
+ if(!ok)
+  filestream_delete(tmp_path.c_str());
+
+ return ok;
+}
+
+static void NVWriter_RunJob(const NVWriteJob& job)
+{
+ if(NVWriter_WriteFile(job.path, job.data))
+  log_cb(RETRO_LOG_DEBUG, "[Mednafen]: Saved \"%s\".\n", job.path.c_str());
+ else
+ {
+  log_cb(RETRO_LOG_ERROR, "[Mednafen]: Error saving \"%s\".\n", job.path.c_str());
+  NVWriter_Failed[job.which].store(true, std::memory_order_relaxed);
+ }
+}
+
+static void NVWriter_ThreadEntry(void* data)
+{
+ slock_lock(NVWriter_Lock);
+
+ for(;;)
+ {
+  if(NVWriter_Queue.empty())
+  {
+   if(NVWriter_Exit)
+    break;
+
+   scond_wait(NVWriter_Cond, NVWriter_Lock);
+   continue;
+  }
+
+  NVWriteJob job = std::move(NVWriter_Queue.front());
+  NVWriter_Queue.pop_front();
+  slock_unlock(NVWriter_Lock);
+  //
+  NVWriter_RunJob(job);
+  //
+  slock_lock(NVWriter_Lock);
+ }
+
+ slock_unlock(NVWriter_Lock);
+}
+
+static void NVWriter_Queue_Job(const unsigned which, const char* path, std::vector<uint8>&& data)
+{
+ if(!NVWriter_Thread)
+ {
+  if(!NVWriter_Lock)
+  {
+   NVWriter_Lock = slock_new();
+   NVWriter_Cond = scond_new();
+   for(auto& f : NVWriter_Failed)
+    f.store(false, std::memory_order_relaxed);
+  }
+
+  if(NVWriter_Lock && NVWriter_Cond)
+  {
+   NVWriter_Exit = false;
+   NVWriter_Thread = sthread_create(NVWriter_ThreadEntry, NULL);
+  }
+
+  // No writer thread, so write the file now.
+  if(!NVWriter_Thread)
+  {
+   NVWriter_RunJob({ which, path, std::move(data) });
+   return;
+  }
+ }
+
+ slock_lock(NVWriter_Lock);
+ {
+  bool replaced = false;
+
+  // Supersede a not-yet-started write of the same file.
+  for(auto& j : NVWriter_Queue)
+  {
+   if(j.which == which)
+   {
+    j.path = path;
+    j.data = std::move(data);
+    replaced = true;
+    break;
+   }
+  }
+
+  if(!replaced)
+   NVWriter_Queue.push_back({ which, path, std::move(data) });
+ }
+ scond_signal(NVWriter_Cond);
+ slock_unlock(NVWriter_Lock);
+}
+
+// Finishes any queued writes.
+static MDFN_COLD void NVWriter_Kill(void)
+{
+ if(NVWriter_Thread)
+ {
+  slock_lock(NVWriter_Lock);
+  NVWriter_Exit = true;
+  scond_signal(NVWriter_Cond);
+  slock_unlock(NVWriter_Lock);
+
+  sthread_join(NVWriter_Thread);
+  NVWriter_Thread = NULL;
+ }
+
+ scond_free(NVWriter_Cond);
+ NVWriter_Cond = NULL;
+ slock_free(NVWriter_Lock);
+ NVWriter_Lock = NULL;
+}
+
 void MDFN_BackupSavFile(const uint8 max_backup_count, const char* sav_ext)
 {
    // stub for libretro port
@@ -1054,11 +1729,7 @@ void MDFN_BackupSavFile(const uint8 max_backup_count, const char* sav_ext)
 
 static MDFN_COLD void SaveBackupRAM(void)
 {
- FileStream brs(MDFN_MakeFName(MDFNMKF_SAV, 0, "bkr"), MODE_WRITE_INPLACE);
-
- brs.write(BackupRAM, sizeof(BackupRAM));
-
- brs.close();
+ NVWriter_Queue_Job(NVFILE_BACKUPRAM, MDFN_MakeFName(MDFNMKF_SAV, 0, "bkr"), std::vector<uint8>(BackupRAM, BackupRAM + sizeof(BackupRAM)));
 }
 
 static MDFN_COLD void LoadBackupRAM(void)
@@ -1139,29 +1810,26 @@ static MDFN_COLD void SaveCartNV(void)
 
    if(ext)
    {
-      FileStream nvs(MDFN_MakeFName(MDFNMKF_CART, 0, ext), MODE_WRITE_INPLACE);
+      std::vector<uint8> data((uint8*)nv_ptr, (uint8*)nv_ptr + nv_size);
 
       if(nv16)
       {
          uint64_t i;
-         /* Slow... */
          for(i = 0; i < nv_size; i += 2)
-            nvs.put_BE<uint16>(MDFN_densb<uint16>((uint8*)nv_ptr + i));
+            MDFN_en16msb(&data[i], MDFN_densb<uint16>((uint8*)nv_ptr + i));
       }
-      else
-         nvs.write(nv_ptr, nv_size);
 
-      nvs.close();
+      NVWriter_Queue_Job(NVFILE_CARTNV, MDFN_MakeFName(MDFNMKF_CART, 0, ext), std::move(data));
    }
 }
 
 static MDFN_COLD void SaveRTC(void)
 {
-   FileStream sds(MDFN_MakeFName(MDFNMKF_SAV, 0, "smpc"), MODE_WRITE_INPLACE);
+   MemoryStream sds;
 
    SMPC_SaveNV(&sds);
 
-   sds.close();
+   NVWriter_Queue_Job(NVFILE_RTC, MDFN_MakeFName(MDFNMKF_SAV, 0, "smpc"), std::vector<uint8>(sds.map(), sds.map() + sds.size()));
 }
 
 static MDFN_COLD void LoadRTC(void)
@@ -1374,6 +2042,9 @@ MDFN_COLD int LibRetro_StateAction( StateMem* sm, const unsigned load, const boo
          
       CPU[0].PostStateLoad(load, RecordedNeedEmuICache, NeedEmuICache);
       CPU[1].PostStateLoad(load, RecordedNeedEmuICache, NeedEmuICache);
+      IdleLoop_Reset();
+      SH2Quantum_SlaveSyncTS = 0;
+      SH2Quantum_LockstepUntil = 0;
    }
 
    // Success!
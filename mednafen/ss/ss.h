@@ -79,13 +79,14 @@
   HORRIBLEHACK_VDP1RWDRAWSLOWDOWN= (1U << 3),
   HORRIBLEHACK_VDP1INSTANT	 = (1U << 4),
   /*HORRIBLEHACK_SCUINTDELAY = (1U << 5),*/
+  HORRIBLEHACK_EXACTSH2INTERLEAVE = (1U << 6),
  };
  MDFN_HIDE extern uint32 ss_horrible_hacks;
 #endif
 
  #define WORKRAM_BANK_SIZE_BYTES (1024*1024)
 
-  extern uint8 WorkRAM[2*WORKRAM_BANK_SIZE_BYTES]; // unified 2MB work ram for linear access.
+  extern uint8 (&WorkRAM)[2*WORKRAM_BANK_SIZE_BYTES]; // unified 2MB work ram for linear access.
 
 
  typedef int32 sscpu_timestamp_t;
@@ -153,6 +154,9 @@
  // is_writeable is mostly for cheat stuff.
  void SS_SetPhysMemMap(uint32 Astart, uint32 Aend, uint16* ptr, uint32 length, bool is_writeable = false) MDFN_COLD;
 
+ // Call from init code; registers a large memory block for the resident memory report logged after init.
+ void SS_RegisterMemoryRegion(const char* subsystem, const void* ptr, size_t length) MDFN_COLD;
+
  void SS_Reset(bool powering_up) MDFN_COLD;
 
 #endif
@@ -117,6 +117,32 @@ static uint32 InstantDrawSanityLimit; // ss_horrible_hacks
 
 uint16 VRAM[0x40000];
 uint16 FB[2][0x20000];
+
+enum : unsigned { TexCache_NumEntries = 512 };
+enum : uint32 { TexCache_EndCode = 0x80000000 };	// Never returned by TexFetch()
+
+struct tex_cache_entry
+{
+ uint64 stamp;
+ uint32 tex_base;
+ uint32 length;
+ uint32 cb_or;
+ uint8 mode;
+ bool valid;
+ uint16 CLUT[0x10];
+ uint32 texels[0x200];
+};
+
+uint64 TexCache_Epoch;
+uint64 TexCache_PageStamp[0x40000 >> TexCache_PageShift];
+static tex_cache_entry TexCache[TexCache_NumEntries];
+
+static void TexCache_Invalidate(void)
+{
+ for(auto& e : TexCache)
+  e.valid = false;
+}
+
 //
 //
 //
@@ -133,6 +159,10 @@ void Init(void)
 {
  vbcdpending = false;
 
+ SS_RegisterMemoryRegion("VDP1", VRAM, sizeof(VRAM));
+ SS_RegisterMemoryRegion("VDP1", FB, sizeof(FB));
+ SS_RegisterMemoryRegion("VDP1", TexCache, sizeof(TexCache));
+
  for(int i = 0; i < 0x40; i++)
  {
   gouraud_lut[i] = std::min<int>(31, std::max<int>(0, i - 16));
@@ -185,6 +215,7 @@ void Reset(bool powering_up)
    for(unsigned i = 0; i < 0x20000; i++)
     FB[fb][i] = 0xFFFF;
 
+  TexCache_Invalidate();
   memset(&LineData, 0, sizeof(LineData));
   memset(&LineInnerData, 0, sizeof(LineInnerData));
   memset(&PrimData, 0, sizeof(PrimData));
@@ -397,6 +428,75 @@ MDFN_HIDE extern uint32 (MDFN_FASTCALL *const TexFetchTab[0x20])(uint32 x) =
  #undef TF
 };
 
+static uint32 MDFN_FASTCALL TexFetchCached(uint32 x)
+{
+ if(MDFN_UNLIKELY(x >= LineData.tex_row_len))
+  return LineData.tex_row_miss_fn(x);
+
+ const uint32 ret = LineData.tex_row[x];
+
+ if(MDFN_UNLIKELY(ret == TexCache_EndCode))
+ {
+  LineData.ec_count--;
+  return -1;
+ }
+
+ return ret;
+}
+
+void SetupTexRow(const uint16 mode, const uint32 length)
+{
+ const unsigned m = (mode >> 3) & 0x1F;
+ const unsigned cm = m & 0x7;
+ const uint32 base = LineData.tex_base;
+ const uint32 cb_or = (cm == 1 || cm >= 5) ? 0 : LineData.cb_or;
+ uint32 first, last;
+
+ LineData.tffn = TexFetchTab[m];
+
+ if(cm >= 6)
+  first = last = 0;
+ else
+ {
+  first = base & 0x3FFFF;
+  last = first + ((length - 1) >> ((cm <= 1) ? 2 : ((cm <= 4) ? 1 : 0)));
+
+  if(last > 0x3FFFF)
+   return;
+ }
+
+ tex_cache_entry* e = &TexCache[(((base * 2654435761U) >> 16) ^ m) & (TexCache_NumEntries - 1)];
+
+ if(!e->valid || e->tex_base != base || e->length != length || e->mode != m || e->cb_or != cb_or ||
+	(cm == 1 && memcmp(e->CLUT, LineData.CLUT, sizeof(e->CLUT))) ||
+	TexCache_PageStamp[first >> TexCache_PageShift] >= e->stamp || TexCache_PageStamp[last >> TexCache_PageShift] >= e->stamp)
+ {
+  const int32 ec_count_saved = LineData.ec_count;
+
+  e->stamp = ++TexCache_Epoch;
+  e->tex_base = base;
+  e->length = length;
+  e->cb_or = cb_or;
+  e->mode = m;
+  e->valid = true;
+  memcpy(e->CLUT, LineData.CLUT, sizeof(e->CLUT));
+
+  for(uint32 x = 0; x < length; x++)
+  {
+   LineData.ec_count = 2;
+   const uint32 texel = LineData.tffn(x);
+
+   e->texels[x] = (LineData.ec_count != 2) ? (uint32)TexCache_EndCode : texel;
+  }
+  LineData.ec_count = ec_count_saved;
+ }
+
+ LineData.tex_row = e->texels;
+ LineData.tex_row_len = length;
+ LineData.tex_row_miss_fn = LineData.tffn;
+ LineData.tffn = TexFetchCached;
+}
+
 bool SetupDrawLine(int32* const cycle_counter, const bool AA, const bool Textured, const uint16 mode)
 {
  const bool HSS = (mode & 0x1000);
@@ -859,7 +959,10 @@ void SetHBVB(const sscpu_timestamp_t event_timestamp, const bool new_hb_status,
    {
 #if 1
     if((ss_horrible_hacks & HORRIBLEHACK_VDP1VRAM5000FIX) && DrawingActive && VRAM[0] == 0x5000 && VRAM[1] == 0x0000)
+    {
+     TexCache_MarkWritten(0);
      VRAM[0] = 0x8000;
+    }
 #endif
 
     if(DrawingActive)
@@ -910,17 +1013,57 @@ void SetHBVB(const sscpu_timestamp_t event_timestamp, const bool new_hb_status,
  vbcdpending |= old_vb_status ^ vb_status;
 }
 
-bool GetLine(const int line, uint16* buf, unsigned w, uint32 rot_x, uint32 rot_y, uint32 rot_xinc, uint32 rot_yinc)
+//
+// Called on the emulation thread for each displayed line; captures what FetchLine() needs and advances the
+// display-framebuffer erase.  Only erase writes touch FB[!FBDrawWhich] while the display is active, and
+// framebuffers swap only on leaving v-blank(after the VDP2 renderer has drained), so FetchLine() can work on
+// the display framebuffer directly from the render thread without a per-line copy here.
+//
+bool SetupLine(const int line, LineFetch* lf, unsigned w, uint32 rot_x, uint32 rot_y, uint32 rot_xinc, uint32 rot_yinc)
 {
- bool ret = false;
- //
- //
- //
- if(TVMR & TVMR_ROTATE)
+ lf->fb = FB[!FBDrawWhich];
+ lf->line = line;
+ lf->w = w;
+ lf->tvmr = TVMR;
+ lf->rot_x = rot_x;
+ lf->rot_y = rot_y;
+ lf->rot_xinc = rot_xinc;
+ lf->rot_yinc = rot_yinc;
+ lf->erase_row = NULL;
+
+ if(EraseYCounter <= EraseParams.y_end)
+ {
+  uint16* fbyptr = &FB[!FBDrawWhich][(EraseYCounter & 0xFF) << 9];
+
+  if(EraseParams.rot8)
+   fbyptr += (EraseYCounter & 0x100);
+
+  lf->erase_row = fbyptr;
+  lf->erase_x_start = EraseParams.x_start;
+  lf->erase_count = std::max<uint32>(2, EraseParams.x_bound - std::min<uint32>(EraseParams.x_bound, EraseParams.x_start));
+  lf->erase_x_mask = EraseParams.fb_x_mask;
+  lf->erase_fill = EraseParams.fill_data;
+
+  EraseYCounter++;
+ }
+
+ return !(TVMR & TVMR_ROTATE) && (TVMR & TVMR_8BPP);
+}
+
+//
+// Called on the VDP2 render thread, in line order.
+//
+void FetchLine(const LineFetch& lf, uint16* buf)
+{
+ const unsigned w = lf.w;
+ uint32 rot_x = lf.rot_x;
+ uint32 rot_y = lf.rot_y;
+
+ if(lf.tvmr & TVMR_ROTATE)
  {
-  const uint16* fbptr = FB[!FBDrawWhich];
+  const uint16* fbptr = lf.fb;
 
-  if(TVMR & TVMR_8BPP)
+  if(lf.tvmr & TVMR_8BPP)
   {
    for(unsigned i = 0; MDFN_LIKELY(i < w); i++)
    {
@@ -937,8 +1080,8 @@ bool GetLine(const int line, uint16* buf, unsigned w, uint32 rot_x, uint32 rot_y
      buf[i] = 0xFF00 | tmp;
     }
 
-    rot_x += rot_xinc;
-    rot_y += rot_yinc;
+    rot_x += lf.rot_xinc;
+    rot_y += lf.rot_yinc;
    }
   }
   else
@@ -953,47 +1096,32 @@ bool GetLine(const int line, uint16* buf, unsigned w, uint32 rot_x, uint32 rot_y
     else
      buf[i] = fbptr[(fb_y << 9) + fb_x];
 
-    rot_x += rot_xinc;
-    rot_y += rot_yinc;
+    rot_x += lf.rot_xinc;
+    rot_y += lf.rot_yinc;
    }
   }
  }
  else
- {
-  const uint16* fbyptr = &FB[!FBDrawWhich][(line & 0xFF) << 9];
-
-  if(TVMR & TVMR_8BPP)
-   ret = true;
-
-  for(unsigned i = 0; MDFN_LIKELY(i < w); i++)
-   buf[i] = fbyptr[i];
- }
+  memcpy(buf, &lf.fb[(lf.line & 0xFF) << 9], w * sizeof(uint16));
 
  //
+ // Erase the row as a block fill, splitting it where the x coordinate wraps around the row.
  //
- //
- if(EraseYCounter <= EraseParams.y_end)
+ if(lf.erase_row)
  {
-  uint16* fbyptr;
-  uint32 x = EraseParams.x_start;
-
-  fbyptr = &FB[!FBDrawWhich][(EraseYCounter & 0xFF) << 9];
-  if(EraseParams.rot8)
-   fbyptr += (EraseYCounter & 0x100);
+  const uint32 row_size = lf.erase_x_mask + 1;
+  const uint32 x = lf.erase_x_start & lf.erase_x_mask;
 
-  do
+  if(lf.erase_count >= row_size)
+   std::fill_n(lf.erase_row, row_size, lf.erase_fill);
+  else
   {
-   for(unsigned sub = 0; sub < 2; sub++)
-   {
-    fbyptr[x & EraseParams.fb_x_mask] = EraseParams.fill_data;
-    x++;
-   }
-  } while(x < EraseParams.x_bound);
+   const uint32 first = std::min<uint32>(lf.erase_count, row_size - x);
 
-  EraseYCounter++;
+   std::fill_n(lf.erase_row + x, first, lf.erase_fill);
+   std::fill_n(lf.erase_row, lf.erase_count - first, lf.erase_fill);
+  }
  }
-
- return ret;
 }
 
 void AdjustTS(const int32 delta)
@@ -1121,6 +1249,7 @@ MDFN_FASTCALL void Write8_DB(uint32 A, uint16 DB)
  if(A < 0x80000)
  {
   VRAMUsageWrite(A >> 1);
+  TexCache_MarkWritten(A >> 1);
   ne16_wbo_be<uint8>(VRAM, A, DB >> (((A & 1) ^ 1) << 3) );
   return;
  }
@@ -1146,6 +1275,7 @@ MDFN_FASTCALL void Write16_DB(uint32 A, uint16 DB)
  if(A < 0x80000)
  {
   VRAMUsageWrite(A >> 1);
+  TexCache_MarkWritten(A >> 1);
   VRAM[A >> 1] = DB;
   return;
  }
@@ -1164,6 +1294,21 @@ MDFN_FASTCALL void Write16_DB(uint32 A, uint16 DB)
  WriteReg((A - 0x100000) >> 1, DB);
 }
 
+void WriteVRAMBlock16(uint32 A, const uint16* src, uint32 count)
+{
+ A &= 0x7FFFE;
+
+ for(uint32 p = (A >> 1) >> TexCache_PageShift; p <= ((A >> 1) + std::max<uint32>(count, 1) - 1) >> TexCache_PageShift; p++)
+  TexCache_PageStamp[p] = TexCache_Epoch;
+
+ memcpy(&VRAM[A >> 1], src, count * sizeof(uint16));
+}
+
+void VRAMWritten(uint32 A)
+{
+ TexCache_MarkWritten((A & 0x7FFFE) >> 1);
+}
+
 MDFN_FASTCALL uint16 Read16_DB(uint32 A)
 {
  A &= 0x1FFFFE;
@@ -1347,6 +1492,8 @@ void StateAction(StateMem* sm, const unsigned load, const bool data_only)
 
  if(load)
  {
+  TexCache_Invalidate();
+
   CurCommandAddr &= 0x3FFFF;
   if(RetCommandAddr >= 0)
    RetCommandAddr &= 0x3FFFF;
@@ -42,10 +42,29 @@ MDFN_FASTCALL void Read_CheckDrawSlowdown(uint32 A, sscpu_timestamp_t time_thing
 MDFN_FASTCALL void Write8_DB(uint32 A, uint16 DB) MDFN_HOT;
 MDFN_FASTCALL void Write16_DB(uint32 A, uint16 DB) MDFN_HOT;
 MDFN_FASTCALL uint16 Read16_DB(uint32 A) MDFN_HOT;
+void WriteVRAMBlock16(uint32 A, const uint16* src, uint32 count);	// Range must be within VRAM.
+void VRAMWritten(uint32 A);	// For writes to VRAM that don't go through the functions above(e.g. cheats).
 
 void SetHBVB(const sscpu_timestamp_t event_timestamp, const bool new_hb_status, const bool new_vb_status);
 
-bool GetLine(const int line, uint16* buf, unsigned w, uint32 rot_x, uint32 rot_y, uint32 rot_xinc, uint32 rot_yinc);
+struct LineFetch
+{
+ const uint16* fb;
+ uint32 rot_x, rot_y;
+ uint32 rot_xinc, rot_yinc;
+ uint16 line;
+ uint16 w;
+ uint8 tvmr;
+
+ uint16* erase_row;	// NULL if no erase is pending for this line.
+ uint16 erase_x_start;
+ uint16 erase_count;
+ uint16 erase_x_mask;
+ uint16 erase_fill;
+};
+
+bool SetupLine(const int line, LineFetch* lf, unsigned w, uint32 rot_x, uint32 rot_y, uint32 rot_xinc, uint32 rot_yinc);
+void FetchLine(const LineFetch& lf, uint16* buf);
 
 //
 //
@@ -51,6 +51,23 @@ MDFN_HIDE extern int32 LocalX, LocalY;
 
 MDFN_HIDE extern uint32 (MDFN_FASTCALL *const TexFetchTab[0x20])(uint32 x);
 
+//
+// Decoded texel rows of sprites, so redrawing the same sprite doesn't go through TexFetch() for every texel.
+// A row is stale once either VRAM page it was decoded from has been written since; VRAM writers must call
+// TexCache_MarkWritten().
+//
+enum : unsigned { TexCache_PageShift = 10 };
+MDFN_HIDE extern uint64 TexCache_Epoch;
+MDFN_HIDE extern uint64 TexCache_PageStamp[0x40000 >> TexCache_PageShift];
+
+static INLINE void TexCache_MarkWritten(uint32 word_addr)
+{
+ TexCache_PageStamp[(word_addr & 0x3FFFF) >> TexCache_PageShift] = TexCache_Epoch;
+}
+
+// Sets LineData.tffn for the texel row at LineData.tex_base, "length" texels wide.
+void SetupTexRow(const uint16 mode, const uint32 length);
+
 enum { TVMR_8BPP   = 0x1 };
 enum { TVMR_ROTATE = 0x2 };
 enum { TVMR_HDTV   = 0x4 };
@@ -411,6 +428,9 @@ struct line_data
  uint16 CLUT[0x10];
  uint32 cb_or;
  uint32 tex_base;
+ const uint32* tex_row;	// For TexFetchCached()
+ uint32 tex_row_len;
+ uint32 (MDFN_FASTCALL *tex_row_miss_fn)(uint32);
 };
 
 MDFN_HIDE extern line_data LineData;
@@ -81,7 +81,7 @@ static int32 SpriteResumeBase(const uint16* cmd_data)
 {
  const uint16 mode = cmd_data[0x2];
  auto* fnptr = LineFuncTab[(bool)(FBCR & FBCR_DIE)][(TVMR & TVMR_8BPP) ? ((TVMR & TVMR_ROTATE) ? 2 : 1) : 0][(mode >> 6) & 0x1F][(mode & 0x8000) ? 8 : (mode & 0x7)];
- LineData.tffn = TexFetchTab[(mode >> 3) & 0x1F];
+ const uint32 tex_row_len = std::max<uint32>(((cmd_data[0x5] >> 8) & 0x3F) << 3, 1);
  //
  //
  //
@@ -95,6 +95,7 @@ static int32 SpriteResumeBase(const uint16* cmd_data)
  if(MDFN_UNLIKELY(PrimData.need_line_resume))
  {
   PrimData.need_line_resume = false;
+  SetupTexRow(mode, tex_row_len);	// VRAM may have been written since the line was suspended.
   goto ResumeLine;
  }
 
@@ -106,6 +107,7 @@ static int32 SpriteResumeBase(const uint16* cmd_data)
    e[1].GetVertex<gourauden>(&LineData.p[1]);
 
    LineData.tex_base = tex_base + big_t.PreStep();
+   SetupTexRow(mode, tex_row_len);
    //
    if(!SetupDrawLine(&ret, true, true, mode) || !iter)
    {
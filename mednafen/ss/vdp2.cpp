@@ -525,7 +525,8 @@ static INLINE int32 AddHCounter(const sscpu_timestamp_t event_timestamp, int32 c
       r.DKAx = rp.DKAx;
      }
     }
-    lib->vdp1_hires8 = VDP1::GetLine(VCounter, lib->vdp1_line, (HRes & 1) ? 352 : 320, (int32)RotParams[0].XstAccum >> 1, (int32)RotParams[0].YstAccum >> 1, (int32)RotParams[0].DX >> 1, (int32)RotParams[0].DY >> 1); // Always call, has side effects.
+    lib->vdp1_hires8 = VDP1::SetupLine(VCounter, &lib->vdp1_fetch, (HRes & 1) ? 352 : 320, (int32)RotParams[0].XstAccum >> 1, (int32)RotParams[0].YstAccum >> 1, (int32)RotParams[0].DX >> 1, (int32)RotParams[0].DY >> 1); // Always call, has side effects.
+    VDP2REND_FetchVDP1Line(VCounter);
     VDP2REND_DrawLine(InternalVB ? -1 : VCounter, CRTLineCounter, !Odd);
     CRTLineCounter++;
    }
@@ -811,6 +812,22 @@ uint16 Read16_DB(uint32 A)
 }
 
 
+uint32 GetVRAMPenalty(uint32 A)
+{
+ return VRAMPenalty[((A & 0x7FFFF) >> 1) >> 16];
+}
+
+void WriteVRAMBlock16(uint32 A, const uint16* src, uint32 count)
+{
+ A &= 0x7FFFE;
+
+ for(uint32 i = 0; i < count; i++, A += 2)
+ {
+  VDP2REND_Write16_DB(A, src[i]);
+  VRAM[A >> 1] = src[i];
+ }
+}
+
 uint32 Write8_DB(uint32 A, uint16 DB)
 {
  VDP2REND_Write8_DB(A, DB);
@@ -836,7 +853,7 @@ void AdjustTS(const int32 delta)
 }
 
 
-void Init(const bool IsPAL, const uint64 affinity)
+void Init(const bool IsPAL, const uint64 affinity, const bool lean_memory)
 {
  SurfInterlaceField = -1;
  PAL = IsPAL;
@@ -846,9 +863,12 @@ void Init(const bool IsPAL, const uint64 affinity)
 
  SS_SetPhysMemMap(0x05E00000, 0x05EFFFFF, VRAM, 0x80000, true);
 
+ SS_RegisterMemoryRegion("VDP2", VRAM, sizeof(VRAM));
+ SS_RegisterMemoryRegion("VDP2", CRAM, sizeof(CRAM));
+
  ExLatchIn = false;
 
- VDP2REND_Init(IsPAL, affinity);
+ VDP2REND_Init(IsPAL, affinity, lean_memory);
 }
 
 void SetGetVideoParams(MDFNGI* gi, const bool caspect, const int sls, const int sle, const bool show_h_overscan, const bool dohblend)
@@ -28,8 +28,10 @@ namespace VDP2
 uint32 Write8_DB(uint32 A, uint16 DB) MDFN_HOT;
 uint32 Write16_DB(uint32 A, uint16 DB) MDFN_HOT;
 uint16 Read16_DB(uint32 A) MDFN_HOT;
+uint32 GetVRAMPenalty(uint32 A);
+void WriteVRAMBlock16(uint32 A, const uint16* src, uint32 count);	// Range must not cross a 128KiB VRAM boundary.
 
-void Init(const bool IsPAL, const uint64 affinity) MDFN_COLD;
+void Init(const bool IsPAL, const uint64 affinity, const bool lean_memory) MDFN_COLD;
 void SetGetVideoParams(MDFNGI* gi, const bool caspect, const int sls, const int sle, const bool show_h_overscan, const bool dohblend) MDFN_COLD;
 void Kill(void) MDFN_COLD;
 void StateAction(StateMem* sm, const unsigned load, const bool data_only) MDFN_COLD;
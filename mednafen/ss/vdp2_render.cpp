@@ -27,6 +27,7 @@
 #include "ss.h"
 #include "ss_memory.h"
 #include <mednafen/mednafen.h>
+#include "vdp1.h"
 #include "vdp2_common.h"
 #include "vdp2_render.h"
 
@@ -2646,6 +2647,33 @@ static void ReorderRGB(uint32* target, const unsigned w, const unsigned Rshift,
  }
 }
 
+// Only touched by the render thread.
+static uint32 OverflowLine[704 + 16];
+
+//
+// The output surface may be a frontend-owned framebuffer sized to the previous frame.  When a line doesn't fit it,
+// the rows drawn so far are copied into the fallback surface, which is used for the rest of the frame.  Without a
+// fallback, the line is drawn into a scratch line and dropped.
+//
+static bool LineFitsSurface(const uint16 out_line, const int32 out_w)
+{
+ if(MDFN_LIKELY(out_line < espec->surface->h && (espec->DisplayRect.x + out_w) <= espec->surface->pitchinpix))
+  return true;
+
+ MDFN_Surface* const fb = espec->fallback_surface;
+
+ if(!fb)
+  return false;
+
+ for(int32 y = 0; y < std::min<int32>(out_line, espec->surface->h); y++)
+  memcpy(fb->pixels + y * fb->pitchinpix, espec->surface->pixels + y * espec->surface->pitchinpix, std::min<int32>(fb->pitchinpix, espec->surface->pitchinpix) * sizeof(uint32));
+
+ espec->surface = fb;
+ espec->fallback_surface = NULL;
+
+ return out_line < fb->h && (espec->DisplayRect.x + out_w) <= fb->pitchinpix;
+}
+
 static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, const bool field)
 {
  uint32* target;
@@ -2655,8 +2683,10 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
  const int32 tvxo = std::max<int32>(0, (int32)(tvdw - w) >> 1);
  uint32 back_rgb24;
  uint32 border_ncf;
+ const int32 out_w = (DoHBlend && !(HRes & 0x2)) ? (tvdw << 1) : tvdw;
+ uint32* const line_base = LineFitsSurface(out_line, out_w) ? (espec->surface->pixels + out_line * espec->surface->pitchinpix) : OverflowLine;
 
- target = espec->surface->pixels + out_line * espec->surface->pitchinpix;
+ target = line_base;
  espec->LineWidths[out_line] = tvdw;
 
  if(!ShowHOverscan)
@@ -2732,8 +2762,11 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
 
  if(vdp2_line == 0xFFFF)
  {
-  for(int32 i = 0; i < tvdw; i++)
-   target[i] = border_ncf;
+  if(!espec->skip)
+  {
+   for(int32 i = 0; i < tvdw; i++)
+    target[i] = border_ncf;
+  }
  }
  else
  {
@@ -2866,6 +2899,31 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
    //printf("WinControl[WINLAYER_CC]=%02x\n", WinControl[WINLAYER_CC]);
   }
 
+  for(unsigned n = 0; n < 4; n++)
+  {
+   if(!MosaicVCount || !(MZCTL & (1U << n)))
+   {
+    if(n < 2)
+    {
+     MosEff_YCoordAccum[n] = YCoordAccum[n];	// Don't + (InterlaceMode == IM_DOUBLE && field)
+    }
+    else
+    {
+     MosEff_NBG23_YCounter[n & 1] = NBG23_YCounter[n & 1] + (InterlaceMode == IM_DOUBLE && field);
+    }
+   }
+  }
+
+  if(SCRCTL & 0x0101)
+   FetchVCScroll(w);	// Call after handling line scroll, and before DrawNBG() stuff
+
+  //
+  // Nothing below affects state carried to later lines(that's all above, and the accumulator updates after
+  // SkipLayers), so it's all skipped when the frame won't be shown.
+  //
+  if(MDFN_UNLIKELY(espec->skip))
+   goto SkipLayers;
+
   //
   // Process sprite data before NBG0-3 and RBG0-1, but defer applying the window until after NBG and RBG are handled(so the sprite window
   // bit in the sprite linebuffer data isn't trashed prematurely).
@@ -2964,27 +3022,6 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
    MDFN_FastArraySet(LB.lc, CurLCColor & 0x7F, w);
    MDFN_FastArraySet(LB.rbg0, 0, w);
   }
-  //
-  //
-  //
-  for(unsigned n = 0; n < 4; n++)
-  {
-   if(!MosaicVCount || !(MZCTL & (1U << n)))
-   {
-    if(n < 2)
-    {
-     MosEff_YCoordAccum[n] = YCoordAccum[n];	// Don't + (InterlaceMode == IM_DOUBLE && field)
-    }
-    else
-    {
-     MosEff_NBG23_YCounter[n & 1] = NBG23_YCounter[n & 1] + (InterlaceMode == IM_DOUBLE && field);
-    }
-   }
-  }
-
-  if(SCRCTL & 0x0101)
-   FetchVCScroll(w);	// Call after handling line scroll, and before DrawNBG() stuff
-
   if(!(BGON & 0x20))
   {
    for(unsigned n = 0; n < 4; n++)
@@ -3099,6 +3136,8 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
   //
   //
   //
+  SkipLayers:;
+  //
   // FIXME: Timing
   //
   for(unsigned n = 0; n < 2; n++)
@@ -3116,9 +3155,12 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
  //
  //
  //
+ if(MDFN_UNLIKELY(espec->skip))
+  return;
+
  if(DoHBlend)
  {
-  espec->LineWidths[out_line] = ApplyHBlend(espec->surface->pixels + out_line * espec->surface->pitchinpix + espec->DisplayRect.x, espec->LineWidths[out_line]);
+  espec->LineWidths[out_line] = ApplyHBlend(line_base + espec->DisplayRect.x, espec->LineWidths[out_line]);
 
   // Kind of late, but meh. ;p
   assert((espec->DisplayRect.x + espec->LineWidths[out_line]) <= 704);
@@ -3136,6 +3178,7 @@ enum
  COMMAND_WRITE16,
 
  COMMAND_DRAW_LINE,
+ COMMAND_FETCH_VDP1_LINE,
 
  COMMAND_SET_LEM,
 
@@ -3153,16 +3196,37 @@ struct WQ_Entry
 };
 
 static std::array<WQ_Entry, 0x80000> WQ;
+static size_t WQ_Capacity;	// Entries of WQ in use(power of 2); only changed by the emulation thread while WQ is empty.
 static size_t WQ_ReadPos, WQ_WritePos;
 static std::atomic_uint_least32_t WQ_InCount;
 static std::atomic_int_least32_t DrawCounter;
 static bool DoBusyWait;
 static bool DoWakeupIfNecessary;
 
+static NO_INLINE void WWQ_Full(void)
+{
+ if(WQ_Capacity < WQ.size())
+ {
+  //
+  // Grow once the render thread has drained the queue; read and write positions are equal and less than
+  // the old capacity at that point, so they stay valid.
+  //
+  while(WQ_InCount.load(std::memory_order_acquire) != 0)
+   retro_sleep(1);
+
+  WQ_Capacity <<= 1;
+ }
+ else
+ {
+  while(WQ_InCount.load(std::memory_order_acquire) == WQ_Capacity)
+   retro_sleep(1);
+ }
+}
+
 static INLINE void WWQ(uint16 command, uint32 arg32 = 0, uint16 arg16 = 0)
 {
- while(MDFN_UNLIKELY(WQ_InCount.load(std::memory_order_acquire) == WQ.size()))
-  retro_sleep(1);
+ if(MDFN_UNLIKELY(WQ_InCount.load(std::memory_order_acquire) == WQ_Capacity))
+  WWQ_Full();
 
  WQ_Entry* wqe = &WQ[WQ_WritePos];
 
@@ -3170,7 +3234,7 @@ static INLINE void WWQ(uint16 command, uint32 arg32 = 0, uint16 arg16 = 0)
  wqe->Arg16 = arg16;
  wqe->Arg32 = arg32;
 
- WQ_WritePos = (WQ_WritePos + 1) % WQ.size();
+ WQ_WritePos = (WQ_WritePos + 1) & (WQ_Capacity - 1);
  WQ_InCount.fetch_add(1, std::memory_order_release);
 }
 
@@ -3218,6 +3282,11 @@ static void/*int*/ RThreadEntry(void* data)
 	DrawCounter.fetch_sub(1, std::memory_order_release);
 	break;
 
+   case COMMAND_FETCH_VDP1_LINE:
+	VDP1::FetchLine(LIB[wqe->Arg32].vdp1_fetch, LIB[wqe->Arg32].vdp1_line);
+	DrawCounter.fetch_sub(1, std::memory_order_release);
+	break;
+
    case COMMAND_RESET:
 	Reset(wqe->Arg32);
 	break;
@@ -3237,7 +3306,7 @@ static void/*int*/ RThreadEntry(void* data)
   //
   //
   //
-  WQ_ReadPos = (WQ_ReadPos + 1) % WQ.size();
+  WQ_ReadPos = (WQ_ReadPos + 1) & (WQ_Capacity - 1);
   WQ_InCount.fetch_sub(1, std::memory_order_release);
  }
 
@@ -3250,7 +3319,7 @@ static void/*int*/ RThreadEntry(void* data)
 //
 //
 //
-void VDP2REND_Init(const bool IsPAL, const uint64 affinity)
+void VDP2REND_Init(const bool IsPAL, const uint64 affinity, const bool lean_memory)
 {
  PAL = IsPAL;
  VisibleLines = PAL ? 288 : 240;
@@ -3258,10 +3327,14 @@ void VDP2REND_Init(const bool IsPAL, const uint64 affinity)
  UserLayerEnableMask = ~0U;
  Clock28M = false;
  //
+ WQ_Capacity = lean_memory ? 0x2000 : WQ.size();
  WQ_ReadPos = 0;
  WQ_WritePos = 0;
  WQ_InCount.store(0, std::memory_order_release); 
  DrawCounter.store(0, std::memory_order_release);
+ SS_RegisterMemoryRegion("VDP2 renderer", VRAM, sizeof(VRAM));
+ SS_RegisterMemoryRegion("VDP2 renderer", CRAM, sizeof(CRAM));
+ SS_RegisterMemoryRegion("VDP2 renderer", WQ.data(), sizeof(WQ));
  RThread = sthread_create(RThreadEntry, NULL);
 }
 
@@ -3351,6 +3424,12 @@ void VDP2REND_StartFrame(EmulateSpecStruct* espec_arg, const bool clock28m, cons
  espec->DisplayRect.y = LineVisFirst << espec->InterlaceOn;
  espec->DisplayRect.w = 0;
  espec->DisplayRect.h = (LineVisLast + 1 - LineVisFirst) << espec->InterlaceOn;
+ //
+ // Clip to the surface, which can be shorter than a full frame when it's a frontend-provided framebuffer
+ // and there's nothing to fall back on.
+ //
+ if(!espec->fallback_surface)
+  espec->DisplayRect.h = std::max<int32>(0, std::min<int32>(espec->DisplayRect.h, espec->surface->h - espec->DisplayRect.y));
 }
 
 void VDP2REND_EndFrame(void)
@@ -3365,7 +3444,7 @@ void VDP2REND_EndFrame(void)
  ;
 #endif
 
- if(NextOutLine < VisibleLines)
+ if(NextOutLine < VisibleLines && !espec->skip)
  {
   //printf("OutLineCounter(%d) < VisibleLines(%d)\n", OutLineCounter, VisibleLines);
   do
@@ -3376,6 +3455,9 @@ void VDP2REND_EndFrame(void)
    if(espec->InterlaceOn)
     out_line = (out_line << 1) | espec->InterlaceField;
 
+   if(!LineFitsSurface(out_line, 4))
+    continue;
+
    target = espec->surface->pixels + out_line * espec->surface->pitchinpix;
    target[0] = target[1] = target[2] = target[3] = MAKECOLOR(0, 0, 0, 0);
    espec->LineWidths[out_line] = 4;
@@ -3392,6 +3474,16 @@ VDP2Rend_LIB* VDP2REND_GetLIB(unsigned line)
  return &LIB[line];
 }
 
+//
+// LIB[line].vdp1_fetch must have been set up with VDP1::SetupLine(); counted in DrawCounter so VDP2REND_EndFrame()
+// also waits for any pending framebuffer erase to complete.
+//
+void VDP2REND_FetchVDP1Line(unsigned line)
+{
+ DrawCounter.fetch_add(1, std::memory_order_release);
+ WWQ(COMMAND_FETCH_VDP1_LINE, line);
+}
+
 void VDP2REND_DrawLine(const int vdp2_line, const uint32 crt_line, const bool field)
 {
  const unsigned bwthresh = VisibleLines - 48;
@@ -4,8 +4,105 @@
 
 #include "Deinterlacer.h"
 
-Deinterlacer::Deinterlacer() : FieldBuffer(NULL), StateValid(false), DeintType(DEINT_WEAVE)
+#include <rthreads/rthreads.h>
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+enum
+{
+ PASS_FILL = 0,	// Fill in the missing lines(and save the current field, when that can't race with the fill).
+ PASS_STORE	// Save the current field, for DEINT_ADAPTIVE which reads the old same-parity field during the fill.
+};
+
+// Per-channel difference above which a pixel is considered to have moved, for DEINT_ADAPTIVE.
+enum : uint8 { ADAPTIVE_THRESHOLD = 0x18 };
+
+static INLINE uint32 AvgPix(const uint32 a, const uint32 b)
 {
+ return (((a ^ b) & 0xFEFEFEFE) >> 1) + (a & b);
+}
+
+static INLINE bool PixMoved(const uint32 a, const uint32 b)
+{
+ for(unsigned s = 0; s < 32; s += 8)
+ {
+  if(s == ALPHA_SHIFT)
+   continue;
+
+  const int32 d = (int32)((a >> s) & 0xFF) - (int32)((b >> s) & 0xFF);
+
+  if(d > ADAPTIVE_THRESHOLD || d < -ADAPTIVE_THRESHOLD)
+   return true;
+ }
+
+ return false;
+}
+
+static void BlendLine(uint32* const dest, const uint32* const a, const uint32* const b, const int32 w)
+{
+ int32 x = 0;
+
+#if defined(__SSE2__)
+ const __m128i lsb = _mm_set1_epi8(1);
+
+ for(; x + 4 <= w; x += 4)
+ {
+  const __m128i va = _mm_loadu_si128((const __m128i*)(a + x));
+  const __m128i vb = _mm_loadu_si128((const __m128i*)(b + x));
+
+  // _mm_avg_epu8() rounds up, AvgPix() rounds down.
+  _mm_storeu_si128((__m128i*)(dest + x), _mm_sub_epi8(_mm_avg_epu8(va, vb), _mm_and_si128(_mm_xor_si128(va, vb), lsb)));
+ }
+#endif
+
+ for(; x < w; x++)
+  dest[x] = AvgPix(a[x], b[x]);
+}
+
+static void AdaptiveLine(uint32* const dest, const uint32* const prev, const uint32* const above, const uint32* const below, const uint32* const above_old, const uint32* const below_old, const int32 w)
+{
+ int32 x = 0;
+
+#if defined(__SSE2__)
+ const __m128i lsb = _mm_set1_epi8(1);
+ const __m128i thresh = _mm_set1_epi8(ADAPTIVE_THRESHOLD);
+ const __m128i colmask = _mm_set1_epi32(~(0xFF << ALPHA_SHIFT));
+ const __m128i zero = _mm_setzero_si128();
+
+ for(; x + 4 <= w; x += 4)
+ {
+  const __m128i va = _mm_loadu_si128((const __m128i*)(above + x));
+  const __m128i vb = _mm_loadu_si128((const __m128i*)(below + x));
+  const __m128i vao = _mm_loadu_si128((const __m128i*)(above_old + x));
+  const __m128i vbo = _mm_loadu_si128((const __m128i*)(below_old + x));
+  const __m128i vp = _mm_loadu_si128((const __m128i*)(prev + x));
+  const __m128i da = _mm_or_si128(_mm_subs_epu8(va, vao), _mm_subs_epu8(vao, va));
+  const __m128i db = _mm_or_si128(_mm_subs_epu8(vb, vbo), _mm_subs_epu8(vbo, vb));
+  const __m128i over = _mm_and_si128(_mm_subs_epu8(_mm_max_epu8(da, db), thresh), colmask);
+  const __m128i still = _mm_cmpeq_epi32(over, zero);
+  const __m128i interp = _mm_sub_epi8(_mm_avg_epu8(va, vb), _mm_and_si128(_mm_xor_si128(va, vb), lsb));
+
+  _mm_storeu_si128((__m128i*)(dest + x), _mm_or_si128(_mm_and_si128(still, vp), _mm_andnot_si128(still, interp)));
+ }
+#endif
+
+ for(; x < w; x++)
+ {
+  if(PixMoved(above[x], above_old[x]) || PixMoved(below[x], below_old[x]))
+   dest[x] = AvgPix(above[x], below[x]);
+  else
+   dest[x] = prev[x];
+ }
+}
+
+Deinterlacer::Deinterlacer() : StateValid(false), DeintType(DEINT_WEAVE), WorkLock(NULL), WorkCond(NULL), DoneCond(NULL), WorkGen(0), WorkPass(0), WorkNextBand(0), WorkNumBands(0), WorkBandsDone(0), WorkExit(false)
+{
+ FieldBuffer[0] = FieldBuffer[1] = NULL;
+ FieldValid[0] = FieldValid[1] = false;
+
  PrevDRect.x = 0;
  PrevDRect.y = 0;
 
@@ -15,10 +112,15 @@ Deinterlacer::Deinterlacer() : FieldBuffer(NULL), StateValid(false), DeintType(D
 
 Deinterlacer::~Deinterlacer()
 {
- if(FieldBuffer)
+ SetThreadCount(1);
+
+ for(unsigned i = 0; i < 2; i++)
  {
-  delete FieldBuffer;
-  FieldBuffer = NULL;
+  if(FieldBuffer[i])
+  {
+   delete FieldBuffer[i];
+   FieldBuffer[i] = NULL;
+  }
  }
 }
 
@@ -28,13 +130,243 @@ void Deinterlacer::SetType(unsigned dt)
  {
   DeintType = dt;
 
-  LWBuffer.resize(0);
-  if(FieldBuffer)
+  for(unsigned i = 0; i < 2; i++)
   {
-   delete FieldBuffer;
-   FieldBuffer = NULL;
+   LWBuffer[i].resize(0);
+   if(FieldBuffer[i])
+   {
+    delete FieldBuffer[i];
+    FieldBuffer[i] = NULL;
+   }
+  }
+  ClearState();
+ }
+}
+
+void Deinterlacer::SetThreadCount(unsigned count)
+{
+ const size_t num_workers = count ? (count - 1) : 0;
+
+ if(Workers.size() == num_workers)
+  return;
+
+ if(Workers.size())
+ {
+  slock_lock(WorkLock);
+  WorkExit = true;
+  scond_broadcast(WorkCond);
+  slock_unlock(WorkLock);
+
+  for(auto* w : Workers)
+   sthread_join(w);
+
+  Workers.clear();
+
+  scond_free(DoneCond);
+  scond_free(WorkCond);
+  slock_free(WorkLock);
+  DoneCond = WorkCond = NULL;
+  WorkLock = NULL;
+ }
+
+ if(num_workers)
+ {
+  WorkLock = slock_new();
+  WorkCond = scond_new();
+  DoneCond = scond_new();
+  WorkExit = false;
+
+  for(size_t i = 0; i < num_workers; i++)
+  {
+   sthread_t* w = sthread_create(WorkerEntry, this);
+
+   if(!w)
+    break;
+
+   Workers.push_back(w);
+  }
+ }
+}
+
+void Deinterlacer::WorkerEntry(void* data)
+{
+ Deinterlacer* const d = (Deinterlacer*)data;
+
+ slock_lock(d->WorkLock);
+
+ uint32 seen_gen = d->WorkGen;
+
+ for(;;)
+ {
+  while(!d->WorkExit && d->WorkGen == seen_gen)
+   scond_wait(d->WorkCond, d->WorkLock);
+
+  if(d->WorkExit)
+   break;
+
+  seen_gen = d->WorkGen;
+  d->RunBands_Locked();
+ }
+
+ slock_unlock(d->WorkLock);
+}
+
+// Called with WorkLock held; grabs bands of the current pass until there are none left.
+void Deinterlacer::RunBands_Locked(void)
+{
+ while(WorkNextBand < WorkNumBands)
+ {
+  const unsigned band = WorkNextBand++;
+
+  slock_unlock(WorkLock);
+  DoBand(band, WorkNumBands);
+  slock_lock(WorkLock);
+
+  if(++WorkBandsDone == WorkNumBands)
+   scond_signal(DoneCond);
+ }
+}
+
+void Deinterlacer::DoBand(const unsigned band, const unsigned num_bands)
+{
+ const int32 y_start = (int64)Job.NumLines * band / num_bands;
+ const int32 y_end = (int64)Job.NumLines * (band + 1) / num_bands;
+
+#if defined(WANT_32BPP)
+ ProcessBand<uint32>(WorkPass, y_start, y_end);
+#elif defined(WANT_16BPP)
+ ProcessBand<uint16>(WorkPass, y_start, y_end);
+#endif
+}
+
+void Deinterlacer::RunPass(const unsigned pass)
+{
+ WorkPass = pass;
+
+ if(!Workers.size())
+ {
+  DoBand(0, 1);
+  return;
+ }
+
+ slock_lock(WorkLock);
+ WorkNextBand = 0;
+ WorkBandsDone = 0;
+ WorkNumBands = Workers.size() + 1;
+ WorkGen++;
+ scond_broadcast(WorkCond);
+
+ RunBands_Locked();
+
+ while(WorkBandsDone != WorkNumBands)
+  scond_wait(DoneCond, WorkLock);
+ slock_unlock(WorkLock);
+}
+
+template<typename T>
+void Deinterlacer::ProcessBand(const unsigned pass, const int32 y_start, const int32 y_end)
+{
+ MDFN_Surface* const surface = Job.surface;
+ const MDFN_Rect& DisplayRect = Job.DisplayRect;
+ int32* const LineWidths = Job.LineWidths;
+ const bool field = Job.field;
+ const int32 pitch = surface->pitchinpix;
+ T* const cur_base = surface->pixels + (field + DisplayRect.y) * pitch + DisplayRect.x;
+ const int32* const cur_lw = &LineWidths[field + DisplayRect.y];
+
+ for(int y = y_start; y < y_end; y++)
+ {
+  const T* src = cur_base + (y * 2) * pitch;
+  const int32 *src_lw = &cur_lw[y * 2];
+
+  if(pass == PASS_FILL)
+  {
+   T* dest = surface->pixels + ((y * 2) + (field ^ 1) + DisplayRect.y) * pitch + DisplayRect.x;
+   int32 *dest_lw = &LineWidths[(y * 2) + (field ^ 1) + DisplayRect.y];
+
+   if(Job.WeaveGood)
+   {
+    const T* prev = FieldBuffer[FBIndex(!field)]->pixels + y * FieldBuffer[FBIndex(!field)]->pitchinpix;
+    const int32 prev_lw = LWBuffer[FBIndex(!field)][y];
+
+    if(DeintType == DEINT_WEAVE)
+    {
+     // The surface isn't necessarily the one the previous field was drawn into(output surfaces are
+     // cycled, and may have a different pitch), so the previous field always has to be copied back in.
+     *dest_lw = std::min<int32>(prev_lw, pitch - DisplayRect.x);
+     memcpy(dest, prev, *dest_lw * sizeof(T));
+    }
+    else if(prev_lw != *src_lw)
+    {
+     *dest_lw = *src_lw;
+     memcpy(dest, src, *src_lw * sizeof(T));
+    }
+    else if(DeintType == DEINT_BLEND)
+    {
+     *dest_lw = *src_lw;
+     BlendLine(dest, prev, src, *src_lw);
+    }
+    else
+    {
+     const int32 ya = std::max<int32>(0, y - field);
+     const int32 yb = std::min<int32>(Job.NumLines - 1, y - field + 1);
+
+     *dest_lw = *src_lw;
+
+     if(!Job.AdaptiveGood || cur_lw[ya * 2] != *src_lw || cur_lw[yb * 2] != *src_lw || LWBuffer[field][ya] != *src_lw || LWBuffer[field][yb] != *src_lw)
+      memcpy(dest, src, *src_lw * sizeof(T));
+     else
+     {
+      const T* old_base = FieldBuffer[field]->pixels;
+      const int32 old_pitch = FieldBuffer[field]->pitchinpix;
+
+      AdaptiveLine(dest, prev, cur_base + (ya * 2) * pitch, cur_base + (yb * 2) * pitch, old_base + ya * old_pitch, old_base + yb * old_pitch, *src_lw);
+     }
+    }
+   }
+   else if(DeintType == DEINT_BOB)
+   {
+    *dest_lw = *src_lw;
+
+    memcpy(dest, src, *src_lw * sizeof(T));
+   }
+   else
+   {
+    const int32 dly = ((y * 2) + (field + 1) + DisplayRect.y);
+
+    dest = surface->pixels + dly * pitch + DisplayRect.x;
+
+    if(y == 0 && field)
+    {
+     T black = MAKECOLOR(0, 0, 0, 0);
+     T* dm2 = surface->pixels + (dly - 2) * pitch;
+
+     LineWidths[dly - 2] = *src_lw;
+
+     for(int x = 0; x < *src_lw; x++)
+      dm2[x] = black;
+    }
+
+    if(dly < (DisplayRect.y + DisplayRect.h))
+    {
+     LineWidths[dly] = *src_lw;
+     memcpy(dest, src, *src_lw * sizeof(T));
+    }
+   }
+  }
+
+  //
+  //
+  //
+  // Reading the previous field above comes before overwriting the same line here, so with a single
+  // field buffer(all but DEINT_ADAPTIVE) this can't race with the fill.
+  if(FieldBuffer[FBIndex(field)] && (pass == PASS_STORE || DeintType != DEINT_ADAPTIVE))
+  {
+   T* dest = FieldBuffer[FBIndex(field)]->pixels + y * FieldBuffer[FBIndex(field)]->pitchinpix;
+
+   memcpy(dest, src, *src_lw * sizeof(T));
+   LWBuffer[FBIndex(field)][y] = *src_lw;
   }
-  StateValid = false;
  }
 }
 
@@ -46,7 +378,12 @@ void Deinterlacer::InternalProcess(MDFN_Surface *surface, MDFN_Rect &DisplayRect
  // while in interlace mode, so clear the first LineWidths entry if it's == ~0, and
  // [...]
  const bool LineWidths_In_Valid = (LineWidths[0] != ~0);
- const bool WeaveGood = (StateValid && PrevDRect.h == DisplayRect.h && DeintType == DEINT_WEAVE);
+ const bool UsesFields = (DeintType == DEINT_WEAVE || DeintType == DEINT_BLEND || DeintType == DEINT_ADAPTIVE);
+
+ if(PrevDRect.h != DisplayRect.h)
+  FieldValid[0] = FieldValid[1] = false;
+
+ const bool WeaveGood = (UsesFields && FieldValid[FBIndex(!field)]);
  //
  // XReposition stuff is to prevent exceeding the dimensions of the video surface under certain conditions(weave deinterlacer, previous field has higher
  // horizontal resolution than current field, and current field's rectangle has an x offset that's too large when taking into consideration the previous field's
@@ -64,82 +401,45 @@ void Deinterlacer::InternalProcess(MDFN_Surface *surface, MDFN_Rect &DisplayRect
   LineWidths[0] = 0;
  }
 
- for(int y = 0; y < DisplayRect.h / 2; y++)
+ //
+ // Line width setup and repositioning are done up front, since the fill reads neighbouring lines.
+ //
+ if(!LineWidths_In_Valid || XReposition)
  {
-  // [...]
-  // set all relevant source line widths to the contents of DisplayRect(also simplifies the src_lw and related pointer calculation code
-  // farther below.
-  if(!LineWidths_In_Valid)
-   LineWidths[(y * 2) + field + DisplayRect.y] = DisplayRect.w;
-
-  if(XReposition)
-  {
-    memmove(surface->pixels + ((y * 2) + field + DisplayRect.y) * surface->pitchinpix,
-	    surface->pixels + ((y * 2) + field + DisplayRect.y) * surface->pitchinpix + XReposition,
-	    LineWidths[(y * 2) + field + DisplayRect.y] * sizeof(T));
-  }
-
-  if(WeaveGood)
-  {
-   const T* src = FieldBuffer->pixels + y * FieldBuffer->pitchinpix;
-   T* dest = surface->pixels + ((y * 2) + (field ^ 1) + DisplayRect.y) * surface->pitchinpix + DisplayRect.x;
-   int32 *dest_lw = &LineWidths[(y * 2) + (field ^ 1) + DisplayRect.y];
-
-   *dest_lw = LWBuffer[y];
-  }
-  else if(DeintType == DEINT_BOB)
+  for(int y = 0; y < DisplayRect.h / 2; y++)
   {
-   const T* src = surface->pixels + ((y * 2) + field + DisplayRect.y) * surface->pitchinpix + DisplayRect.x;
-   T* dest = surface->pixels + ((y * 2) + (field ^ 1) + DisplayRect.y) * surface->pitchinpix + DisplayRect.x;
-   const int32 *src_lw = &LineWidths[(y * 2) + field + DisplayRect.y];
-   int32 *dest_lw = &LineWidths[(y * 2) + (field ^ 1) + DisplayRect.y];
-
-   *dest_lw = *src_lw;
-
-   memcpy(dest, src, *src_lw * sizeof(T));
-  }
-  else
-  {
-   const int32 *src_lw = &LineWidths[(y * 2) + field + DisplayRect.y];
-   const T* src = surface->pixels + ((y * 2) + field + DisplayRect.y) * surface->pitchinpix + DisplayRect.x;
-   const int32 dly = ((y * 2) + (field + 1) + DisplayRect.y);
-   T* dest = surface->pixels + dly * surface->pitchinpix + DisplayRect.x;
-
-   if(y == 0 && field)
-   {
-    T black = MAKECOLOR(0, 0, 0, 0);
-    T* dm2 = surface->pixels + (dly - 2) * surface->pitchinpix;
-
-    LineWidths[dly - 2] = *src_lw;
-
-    for(int x = 0; x < *src_lw; x++)
-     dm2[x] = black;
-   }
+   // [...]
+   // set all relevant source line widths to the contents of DisplayRect(also simplifies the src_lw and related pointer calculation code
+   // farther below.
+   if(!LineWidths_In_Valid)
+    LineWidths[(y * 2) + field + DisplayRect.y] = DisplayRect.w;
 
-   if(dly < (DisplayRect.y + DisplayRect.h))
+   if(XReposition)
    {
-    LineWidths[dly] = *src_lw;
-    memcpy(dest, src, *src_lw * sizeof(T));
+     memmove(surface->pixels + ((y * 2) + field + DisplayRect.y) * surface->pitchinpix,
+	     surface->pixels + ((y * 2) + field + DisplayRect.y) * surface->pitchinpix + XReposition,
+	     LineWidths[(y * 2) + field + DisplayRect.y] * sizeof(T));
    }
   }
+ }
 
-  //
-  //
-  //
-  //
-  //
-  //
-  if(DeintType == DEINT_WEAVE)
-  {
-   const int32 *src_lw = &LineWidths[(y * 2) + field + DisplayRect.y];
-   const T* src = surface->pixels + ((y * 2) + field + DisplayRect.y) * surface->pitchinpix + DisplayRect.x;
-   T* dest = FieldBuffer->pixels + y * FieldBuffer->pitchinpix;
+ Job.surface = surface;
+ Job.DisplayRect = DisplayRect;
+ Job.LineWidths = LineWidths;
+ Job.field = field;
+ Job.WeaveGood = WeaveGood;
+ Job.AdaptiveGood = (WeaveGood && DeintType == DEINT_ADAPTIVE && FieldValid[field]);
+ Job.NumLines = DisplayRect.h / 2;
 
-   memcpy(dest, src, *src_lw * sizeof(uint32));
-   LWBuffer[y] = *src_lw;
+ RunPass(PASS_FILL);
 
-   StateValid = true;
-  }
+ if(UsesFields)
+ {
+  if(DeintType == DEINT_ADAPTIVE)
+   RunPass(PASS_STORE);
+
+  FieldValid[FBIndex(field)] = true;
+  StateValid = true;
  }
 }
 
@@ -147,19 +447,23 @@ void Deinterlacer::Process(MDFN_Surface *surface, MDFN_Rect &DisplayRect, int32
 {
  const MDFN_Rect DisplayRect_Original = DisplayRect;
 
- if(DeintType == DEINT_WEAVE)
+ if(DeintType == DEINT_WEAVE || DeintType == DEINT_BLEND || DeintType == DEINT_ADAPTIVE)
  {
-  if(!FieldBuffer || FieldBuffer->w < surface->w || FieldBuffer->h < (surface->h / 2))
+  for(unsigned i = 0; i <= FBIndex(true); i++)
   {
-   if(FieldBuffer)
-    delete FieldBuffer;
+   if(!FieldBuffer[i] || FieldBuffer[i]->w < surface->w || FieldBuffer[i]->h < (surface->h / 2))
+   {
+    if(FieldBuffer[i])
+     delete FieldBuffer[i];
 
-   FieldBuffer = new MDFN_Surface(NULL, surface->w, surface->h / 2, surface->w, surface->format);
-   LWBuffer.resize(FieldBuffer->h);
-  }
-  else if(memcmp(&surface->format, &FieldBuffer->format, sizeof(MDFN_PixelFormat)))
-  {
-   FieldBuffer->SetFormat(surface->format, StateValid && PrevDRect.h == DisplayRect.h);
+    FieldBuffer[i] = new MDFN_Surface(NULL, surface->w, surface->h / 2, surface->w, surface->format);
+    LWBuffer[i].resize(FieldBuffer[i]->h);
+    FieldValid[0] = FieldValid[1] = false;
+   }
+   else if(memcmp(&surface->format, &FieldBuffer[i]->format, sizeof(MDFN_PixelFormat)))
+   {
+    FieldBuffer[i]->SetFormat(surface->format, FieldValid[i] && PrevDRect.h == DisplayRect.h);
+   }
   }
  }
 
@@ -175,6 +479,7 @@ void Deinterlacer::Process(MDFN_Surface *surface, MDFN_Rect &DisplayRect, int32
 void Deinterlacer::ClearState(void)
 {
  StateValid = false;
+ FieldValid[0] = FieldValid[1] = false;
 
  PrevDRect.x = 0;
  PrevDRect.y = 0;
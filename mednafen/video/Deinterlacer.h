@@ -20,6 +20,10 @@
 
 #include <vector>
 
+struct sthread;
+struct slock;
+struct scond;
+
 class Deinterlacer
 {
  public:
@@ -32,6 +36,8 @@ class Deinterlacer
   DEINT_BOB_OFFSET = 0,	// Code will fall-through to this case under certain conditions, too.
   DEINT_BOB,
   DEINT_WEAVE,
+  DEINT_BLEND,		// Missing lines are the average of the previous field and the line above.
+  DEINT_ADAPTIVE,	// Weave where the picture is still, interpolate where it moved since the last same-parity field.
  };
 
  void SetType(unsigned t);
@@ -40,6 +46,9 @@ class Deinterlacer
   return(DeintType);
  }
 
+ // Number of threads(including the calling one) to split line bands across; 1 to disable.
+ void SetThreadCount(unsigned count);
+
  void Process(MDFN_Surface *surface, MDFN_Rect &DisplayRect, int32 *LineWidths, const bool field);
 
  void ClearState(void);
@@ -49,11 +58,54 @@ class Deinterlacer
  template<typename T>
  void InternalProcess(MDFN_Surface *surface, MDFN_Rect &DisplayRect, int32 *LineWidths, const bool field);
 
- MDFN_Surface *FieldBuffer;
- std::vector<int32> LWBuffer;
+ template<typename T>
+ void ProcessBand(const unsigned pass, const int32 y_start, const int32 y_end);
+
+ void RunPass(const unsigned pass);
+ void RunBands_Locked(void);
+ void DoBand(const unsigned band, const unsigned num_bands);
+ static void WorkerEntry(void* data);
+
+ // DEINT_ADAPTIVE keeps one field buffer per parity, the other modes only need the previous field.
+ inline unsigned FBIndex(const bool parity) const
+ {
+  return (DeintType == DEINT_ADAPTIVE) ? parity : 0;
+ }
+
+ MDFN_Surface *FieldBuffer[2];
+ std::vector<int32> LWBuffer[2];
+ bool FieldValid[2];
  bool StateValid;
  MDFN_Rect PrevDRect;
  unsigned DeintType;
+
+ //
+ // Current job, set up by InternalProcess() and consumed by ProcessBand().
+ //
+ struct
+ {
+  MDFN_Surface* surface;
+  MDFN_Rect DisplayRect;
+  int32* LineWidths;
+  bool field;
+  bool WeaveGood;
+  bool AdaptiveGood;
+  int32 NumLines;
+ } Job;
+
+ //
+ // Band worker threads.
+ //
+ std::vector<sthread*> Workers;
+ slock* WorkLock;
+ scond* WorkCond;
+ scond* DoneCond;
+ uint32 WorkGen;
+ unsigned WorkPass;
+ unsigned WorkNextBand;
+ unsigned WorkNumBands;
+ unsigned WorkBandsDone;
+ bool WorkExit;
 };
 
 #endif
@@ -45,6 +45,7 @@ MDFN_Surface::MDFN_Surface()
    memset(&format, 0, sizeof(format));
 
    pixels = NULL;
+   pixels_is_external = false;
    pitchinpix = 0;
    w = 0;
    h = 0;
@@ -63,10 +64,16 @@ bool MDFN_Surface::Init(void *const p_pixels, const uint32 p_width, const uint32
    format = nf;
 
    pixels = NULL;
+   pixels_is_external = (p_pixels != NULL);
 
-   rpix = calloc(1, p_pitchinpix * p_height * (nf.bpp / 8));
-   if(!rpix)
-      return false;
+   if(pixels_is_external)
+      rpix = p_pixels;
+   else
+   {
+      rpix = calloc(1, p_pitchinpix * p_height * (nf.bpp / 8));
+      if(!rpix)
+         return false;
+   }
 
    pixels = (uint32 *)rpix;
 
@@ -86,9 +93,20 @@ void MDFN_Surface::SetFormat(const MDFN_PixelFormat &nf, bool convert)
    format = nf;
 }
 
+void MDFN_Surface::SetExternalPixels(void *const p_pixels, const uint32 p_width, const uint32 p_height, const uint32 p_pitchinpix)
+{
+   assert(!pixels || pixels_is_external);
+
+   pixels_is_external = true;
+   pixels = (uint32 *)p_pixels;
+   w = p_width;
+   h = p_height;
+   pitchinpix = p_pitchinpix;
+}
+
 MDFN_Surface::~MDFN_Surface()
 {
-   if(pixels)
+   if(pixels && !pixels_is_external)
       free(pixels);
 }
 
@@ -94,8 +94,15 @@ class MDFN_Surface //typedef struct
 
  MDFN_PixelFormat format;
 
+ // True when "pixels" points to caller-owned memory(e.g. a frontend-provided framebuffer), which
+ // must not be freed by the destructor.
+ bool pixels_is_external;
+
  void SetFormat(const MDFN_PixelFormat &new_format, bool convert);
 
+ // Points the surface at caller-owned memory; only for surfaces that don't own their pixels.
+ void SetExternalPixels(void *const p_pixels, const uint32 p_width, const uint32 p_height, const uint32 p_pitchinpix);
+
  // Gets the R/G/B/A values for the passed 32-bit surface pixel value
  INLINE void DecodeColor(uint32 value, int &r, int &g, int &b, int &a) const
  {